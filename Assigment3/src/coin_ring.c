@@ -0,0 +1,54 @@
+/**   @file coin_ring.c
+ *    @brief Lossless ring of coin events
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#include <string.h>
+#include "coin_ring.h"
+
+void coin_ring_init(struct coin_ring *ring)
+{
+    memset(ring, 0, sizeof(*ring));
+}
+
+void coin_ring_put(struct coin_ring *ring, uint8_t type, uint32_t timestamp)
+{
+    uint32_t head = (uint32_t)atomic_get(&ring->head);
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+
+    if (head - tail < COIN_RING_LEN) {
+        ring->ev[head % COIN_RING_LEN].timestamp = timestamp;
+        ring->ev[head % COIN_RING_LEN].type = type;
+        atomic_set(&ring->head, (atomic_val_t)(head + 1));
+    }
+    else {
+        atomic_inc(&ring->dropped[type]);
+    }
+}
+
+int coin_ring_get(struct coin_ring *ring, struct coin_event *ev)
+{
+    uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+    int type;
+
+    if (tail != (uint32_t)atomic_get(&ring->head)) {
+        *ev = ring->ev[tail % COIN_RING_LEN];
+        atomic_set(&ring->tail, (atomic_val_t)(tail + 1));
+        return 0;
+    }
+
+    /* Ring empty: make up the coins that found it full */
+    for (type = 0; type < COIN_TYPES; type++) {
+        if ((uint32_t)atomic_get(&ring->dropped[type]) != ring->made_up[type]) {
+            ev->timestamp = 0;
+            ev->type = type;
+            ring->made_up[type]++;
+            return 0;
+        }
+    }
+
+    return -EAGAIN;
+}
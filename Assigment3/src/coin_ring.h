@@ -0,0 +1,67 @@
+/**   @file coin_ring.h
+ *    @brief Lossless ring of coin events
+ *
+ *    One producer (the input debounce) and one consumer (the state machine).
+ *    If the ring is ever full the producer counts the coin per type instead
+ *    of queueing it, and the consumer makes up those coins once the ring is
+ *    drained. Each coin is either in the ring or counted, never both, so
+ *    no coin is lost or taken twice.
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#ifndef COIN_RING_H
+#define COIN_RING_H
+
+#include <zephyr.h>
+#include <sys/atomic.h>
+
+/**
+ * @{ @name   Coin ring constants
+ *    @brief  Coin types and ring size (a power of two).
+ */
+#define COIN_TYPES      4
+#define COIN_RING_LEN   16
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Coin ring structures
+ *    @brief  A coin of type (0 to COIN_TYPES - 1) inserted at timestamp (uptime in ms).
+ *
+ *    @details head and dropped are only written by the producer, tail and made_up
+ *             only by the consumer.
+ */
+struct coin_event {
+    uint32_t timestamp;
+    uint8_t type;
+};
+
+struct coin_ring {
+    struct coin_event ev[COIN_RING_LEN];
+    atomic_t head;
+    atomic_t tail;
+    atomic_t dropped[COIN_TYPES];       /* coins that found the ring full */
+    uint32_t made_up[COIN_TYPES];       /* dropped coins already taken */
+};
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Coin ring functions
+ *    @brief  coin_ring_put() is for the producer and never fails. coin_ring_get() is for
+ *            the consumer and returns -EAGAIN when every coin has been taken; coins that
+ *            found the ring full come out after it, with timestamp 0.
+ */
+void coin_ring_init(struct coin_ring *ring);
+void coin_ring_put(struct coin_ring *ring, uint8_t type, uint32_t timestamp);
+int coin_ring_get(struct coin_ring *ring, struct coin_event *ev);
+/**
+ * @}
+ */
+
+#endif
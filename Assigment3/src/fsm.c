@@ -0,0 +1,47 @@
+/**   @file fsm.c
+ *    @brief Table-driven finite state machine engine
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#include <stddef.h>
+#include "fsm.h"
+
+void fsm_init(struct fsm *fsm, const struct fsm_def *def, uint8_t initial, void *ctx)
+{
+    fsm->def = def;
+    fsm->state = initial;
+    fsm->ctx = ctx;
+
+    if (def->states[initial].entry != NULL)
+        def->states[initial].entry(ctx);
+}
+
+void fsm_dispatch(struct fsm *fsm, uint8_t event)
+{
+    const struct fsm_def *def = fsm->def;
+    const struct fsm_transition *t;
+    uint8_t next;
+
+    if (event >= def->n_events)
+        return;
+
+    t = &def->table[fsm->state * def->n_events + event];
+    next = t->next;
+    if (next == FSM_IGNORE)
+        return;
+
+    if (t->action != NULL)
+        next = t->action(fsm->ctx, event, next);
+
+    if (next == fsm->state || next >= def->n_states)
+        return;
+
+    if (def->states[fsm->state].exit != NULL)
+        def->states[fsm->state].exit(fsm->ctx);
+    fsm->state = next;
+    if (def->states[next].entry != NULL)
+        def->states[next].entry(fsm->ctx);
+}
@@ -0,0 +1,76 @@
+/**   @file fsm.h
+ *    @brief Table-driven finite state machine engine
+ *
+ *    A machine is described by const tables, so they are placed in flash:
+ *    one row of transitions per state, indexed by event, and one pair of
+ *    entry/exit hooks per state. Dispatching an event is one table lookup.
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#ifndef FSM_H
+#define FSM_H
+
+#include <stdint.h>
+
+/**
+ * @{ @name   FSM constants
+ *    @brief  Value of next for an event that the state ignores.
+ */
+#define FSM_IGNORE      0xff
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   FSM types
+ *    @brief  Actions, hooks and tables.
+ *
+ *    @details An action runs on a transition and returns the state to go to, normally
+ *             the next it receives from the table; returning another state works as a
+ *             guard. Actions and hooks get the ctx pointer given to fsm_init(). A
+ *             transition to the same state is internal: no exit or entry hook runs.
+ */
+typedef uint8_t (*fsm_action_t)(void *ctx, uint8_t event, uint8_t next);
+typedef void (*fsm_hook_t)(void *ctx);
+
+struct fsm_transition {
+    fsm_action_t action;        /* may be NULL */
+    uint8_t next;               /* state, or FSM_IGNORE */
+};
+
+struct fsm_state {
+    fsm_hook_t entry;           /* may be NULL */
+    fsm_hook_t exit;            /* may be NULL */
+};
+
+struct fsm_def {
+    const struct fsm_transition *table;     /* n_states rows of n_events */
+    const struct fsm_state *states;
+    uint8_t n_states;
+    uint8_t n_events;
+};
+
+struct fsm {
+    const struct fsm_def *def;
+    uint8_t state;
+    void *ctx;
+};
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   FSM functions
+ *    @brief  fsm_init() enters the initial state, running its entry hook.
+ *            fsm_dispatch() handles one event; events out of range are ignored.
+ */
+void fsm_init(struct fsm *fsm, const struct fsm_def *def, uint8_t initial, void *ctx);
+void fsm_dispatch(struct fsm *fsm, uint8_t event);
+/**
+ * @}
+ */
+
+#endif
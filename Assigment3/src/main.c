@@ -30,16 +30,20 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include "fsm.h"
+#include "money.h"
+#include "coin_ring.h"
+#include "scanner.h"
 
 
 /**
  * @{ @name   Time constants
- *    @brief  Two global constants.
+ *    @brief  One global constant.
  *
- *    @details These constantes are used in main to set time.
+ *    @details An input must read the same level in every scan over this time (in ms)
+ *             to change, so the contact bounce of a press is one press.
  */
-#define SLEEP_TIME_MS	1
-#define SLEEP   	    300
+#define DEBOUNCE_MS     50
 /**
 * @}
 */
@@ -47,15 +51,15 @@
 
 /**
  * @{ @name   State constants
- *    @brief  Five global constants.
+ *    @brief  Four global constants.
  *
- *    @details These constantes are used in main for the implementation of the states 
+ *    @details States of the vending machine, indexes of the rows of vm_table. Selecting
+ *             and returning the credit need no input, so they are actions, not states.
  */
-#define COINS           1
-#define LIST            2
-#define SELECT          3
-#define RETURN          4 
-#define CHOOSE          5 
+#define COINS           0
+#define LIST            1
+#define CHOOSE          2
+#define N_STATES        3
 /**
  * @}
  */
@@ -76,6 +80,13 @@
 #define SW5_NODE        0x4
 #define SW6_NODE        0x1c
 #define SW7_NODE        0x1d
+
+/* The scanner reads one port, so the development kit buttons must all be on gpio0 */
+BUILD_ASSERT(DT_SAME_NODE(DT_GPIO_CTLR(SW0_NODE, gpios), GPIO0_NID) &&
+             DT_SAME_NODE(DT_GPIO_CTLR(SW1_NODE, gpios), GPIO0_NID) &&
+             DT_SAME_NODE(DT_GPIO_CTLR(SW2_NODE, gpios), GPIO0_NID) &&
+             DT_SAME_NODE(DT_GPIO_CTLR(SW3_NODE, gpios), GPIO0_NID),
+             "sw0 to sw3 must be on gpio0");
 /**
  * @}
  */
@@ -92,27 +103,52 @@ static const struct gpio_dt_spec button3 = GPIO_DT_SPEC_GET_OR(SW2_NODE, gpios,
 							      {0});
 static const struct gpio_dt_spec button4 = GPIO_DT_SPEC_GET_OR(SW3_NODE, gpios,
 							      {0});
-static struct gpio_callback button1_cb_data;
-static struct gpio_callback button2_cb_data;
-static struct gpio_callback button3_cb_data;
-static struct gpio_callback button4_cb_data;
-static struct gpio_callback button5_cb_data;
-static struct gpio_callback button6_cb_data;
-static struct gpio_callback button7_cb_data;
-static struct gpio_callback button8_cb_data;
+static struct scanner scanner;
 const struct device *gpio0_dev;
 /**
  * @}
  */
 
 /**
- * @{  @name Flags
- *     @brief Four global variables.
+ * @{ @name   Event constants
+ *    @brief  Eight global constants.
+ *
+ *    @details Inputs that the scanner posts to the state machine. Buttons 1 to 4
+ *             are on the development kit and buttons 5 to 8 emulate the coins; event i
+ *             is scanner input i.
  */
-int f5 = 0; 
-int f6 = 0; 
-int f7 = 0; 
-int f8 = 0; 
+#define EV_NEXT         0
+#define EV_PREV         1
+#define EV_SELECT       2
+#define EV_RETURN       3
+#define EV_COIN_10      4
+#define EV_COIN_20      5
+#define EV_COIN_50      6
+#define EV_COIN_100     7
+#define EV_COUNT        8
+#define EV_COINS        8   /* doorbell: coins are waiting in coin_ring */
+/**
+ * @}
+ */
+
+
+/**
+ * @{ @name   Event queue
+ *    @brief  Events from the callbacks to the state machine.
+ *
+ *    @details Each event has the input and the uptime (ms) of its first edge. main() sleeps
+ *             on the queue, so the CPU is idle until a button is pressed. Coins go to
+ *             coin_ring, which never loses one, and only ring the doorbell here.
+ */
+struct vm_event {
+    uint32_t timestamp;
+    uint8_t id;
+};
+
+#define EVENT_QUEUE_LEN 16
+K_MSGQ_DEFINE(event_msgq, sizeof(struct vm_event), EVENT_QUEUE_LEN, 4);
+
+static struct coin_ring coin_ring;
 /**
  * @}
  */
@@ -121,313 +157,330 @@ int f8 = 0;
 void conf_buttons();
 
 /**
- * @{ @name   Button Fuctions 1
- *    @brief  Four Functions for the buttons of the Nordik development kit.
- *
- *    @details These four functions aim to read impulses of the buttons of Nordik development kit.
+ * @{ @name   Post Event
+ *    @brief  Queues event id for the state machine.
  *
+ *    @details Never waits. If the queue is full a button press is dropped, but a coin is
+ *             not: it is already in coin_ring and the next event drains it.
  */
-void button1_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
-{
-}
-void button2_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
-{
-}
-void button3_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+static void post_event(uint8_t id, uint32_t timestamp)
 {
+    struct vm_event ev = { .timestamp = timestamp, .id = id };
+
+    k_msgq_put(&event_msgq, &ev, K_NO_WAIT);
 }
-void button4_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Button Function
+ *    @brief  Scanner handler for the eight buttons, called once per scan with the
+ *            debounced edges of all of them (system work queue).
+ *
+ *    @details Buttons 1 to 4 post the navigation events: next, previous, select and return.
+ *             Buttons 5 to 8 emulate the insertion of coins of 0.10, 0.20, 0.50 and 1 EUR;
+ *             every coin goes to coin_ring and the scan rings the doorbell once.
+ */
+static void buttons_scanned(uint8_t edges, uint8_t state, uint32_t timestamp)
 {
+    uint8_t pressed = edges & state;
+    bool coins = false;
+    uint8_t id;
+
+    for (id = 0; id < EV_COUNT; id++) {
+        if (!(pressed & BIT(id)))
+            continue;
+
+        if (id >= EV_COIN_10) {
+            coin_ring_put(&coin_ring, id - EV_COIN_10, timestamp);
+            coins = true;
+        }
+        else {
+            post_event(id, timestamp);
+        }
+    }
+
+    if (coins) {
+        post_event(EV_COINS, timestamp);
+    }
 }
 /**
  * @}
  */
 
 
+
+/**
+ * @{ @name   Products
+ *    @brief  Products, their prices and the two options of each one.
+ */
+struct product {
+    const char *name;
+    money_t price;
+    const char *options[2];
+};
+
+static const struct product products[] = {
+    { "Coffee",        EUR(0, 50), { "With Sugar", "No Sugar" } },
+    { "Tuna sandwich", EUR(1, 0),  { "With Mayonese", "No Mayonese" } },
+    { "Beer",          EUR(1, 50), { "Superbock", "Guinness" } },
+};
+#define N_PRODUCTS      3
+
+/** Value of each coin event, EV_COIN_10 to EV_COIN_100 */
+static const money_t coins[] = { EUR(0, 10), EUR(0, 20), EUR(0, 50), EUR(1, 0) };
+/**
+ * @}
+ */
+
+
 /**
- * @{  @name   Button Fuctions 2
- *     @brief  Four Functions for the external buttons.
+ * @{ @name   Vending machine data
+ *    @brief  Context passed to the actions and hooks of the state machine.
  *
- *    @details These four functions have the objective of emulate the insertion of coins, when the button is press flag goes 1 (fX = 1).
+ *    @details credit is the credit of the vending machine, prod the product on
+ *             display and extra the option of that product on display.
  */
-void button5_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+struct vm {
+    money_t credit;
+    int prod;
+    int extra;
+};
+/**
+ * @}
+ */
+
+
+/**
+ * @{ @name   Vending machine actions
+ *    @brief  Actions of the transitions in vm_table and entry hooks of the states.
+ */
+static void print_credit(money_t credit)
 {
-    f5 = 1;
+    char str[MONEY_STR_LEN];
+
+    printf("\33[2K\rcredit = %s", money_str(credit, str));
 }
-void button6_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+
+static void print_product(const char *fmt, const struct product *p)
 {
-    f6 = 1;
+    char str[MONEY_STR_LEN];
+
+    printf(fmt, p->name, money_str(p->price, str));
 }
-void button7_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+
+/* Adds the coin; the credit is shown when the machine is, or goes back, to COINS */
+static uint8_t vm_coin(void *ctx, uint8_t event, uint8_t next)
 {
-    f7 = 1;
+    struct vm *vm = ctx;
+
+    vm->credit += coins[event - EV_COIN_10];
+    if (next == COINS)
+        print_credit(vm->credit);
+    return next;
 }
-void button8_pressed(const struct device *dev, struct gpio_callback *cb,
-		    uint32_t pins)
+
+static uint8_t vm_coin_list(void *ctx, uint8_t event, uint8_t next)
 {
-    f8 = 1;
+    printf("\n");
+    return vm_coin(ctx, event, next);
 }
-/**
- * @}
- */
 
+/* In CHOOSE the credit replaces the option line and the option is shown again below it */
+static uint8_t vm_coin_choose(void *ctx, uint8_t event, uint8_t next)
+{
+    struct vm *vm = ctx;
 
+    vm_coin(ctx, event, next);
+    print_credit(vm->credit);
+    printf("\n%s", products[vm->prod].options[vm->extra]);
+    return next;
+}
 
-/**
- *
- *  @name   Main
- *  @brief  State machine according with state diagram.
- *          Each case of switch is a state.
- *
- */
+static uint8_t vm_refund(void *ctx, uint8_t event, uint8_t next)
+{
+    struct vm *vm = ctx;
+    char str[MONEY_STR_LEN];
+
+    if (vm->credit <= 0)
+        printf("\nNo credit to return\n\n");
+    else
+        printf("\nCredit returned: %s\n\n", money_str(vm->credit, str));
+    vm->credit = 0;
+    return next;
+}
 
-void main(void)
+/* In LIST, return only works with credit */
+static uint8_t vm_refund_list(void *ctx, uint8_t event, uint8_t next)
 {
+    struct vm *vm = ctx;
 
-/**
- * @param credit Variable that simulate the credit of vending machine.
- */
-	double credit = 0.0; 
+    if (vm->credit <= 0)
+        return LIST;
+    return vm_refund(ctx, event, next);
+}
+
+static uint8_t vm_browse(void *ctx, uint8_t event, uint8_t next)
+{
+    struct vm *vm = ctx;
+
+    vm->prod += event == EV_NEXT ? 1 : N_PRODUCTS - 1;
+    vm->prod %= N_PRODUCTS;
+    print_product("\33[2K\rProduct: %s - Preco: %s", &products[vm->prod]);
+    return next;
+}
+
+static uint8_t vm_option(void *ctx, uint8_t event, uint8_t next)
+{
+    struct vm *vm = ctx;
+
+    vm->extra ^= 1;
+    printf("\33[2K\r%s", products[vm->prod].options[vm->extra]);
+    return next;
+}
+
+/* Sells the product if the credit is enough and returns the change */
+static uint8_t vm_buy(void *ctx, uint8_t event, uint8_t next)
+{
+    struct vm *vm = ctx;
+    money_t price = products[vm->prod].price;
+    char str[MONEY_STR_LEN], str2[MONEY_STR_LEN];
+
+    if (vm->credit < price) {
+        printf("\n\nInsuficient credit: %s\n\nYou need more: %s\n",
+               money_str(vm->credit, str), money_str(price - vm->credit, str2));
+        return COINS;
+    }
+
+    printf("\n\n%s selected\n", products[vm->prod].name);
+    vm->credit -= price;
+    return vm_refund(ctx, event, next);
+}
 
+static void list_entry(void *ctx)
+{
+    struct vm *vm = ctx;
+
+    print_product("\n\nProduct: %s - Price: %s", &products[vm->prod]);
+}
+
+static void choose_entry(void *ctx)
+{
+    struct vm *vm = ctx;
+
+    vm->extra = 0;
+    printf("\n%s", products[vm->prod].options[vm->extra]);
+}
 /**
- * @param need Variable that simulate the credit needed to buy a product.
+ * @}
  */
-	double need = 0.0;
+
 
 /**
- * @param intpart Variable that permits to print the double format.
+ * @{ @name   State machine tables
+ *    @brief  state x event -> (action, next state), and the hooks of each state.
+ *
+ *    @details const, so they stay in flash.
  */
-	int intpart = 0;
-
+#define IGNORE          { NULL, FSM_IGNORE }
+
+static const struct fsm_transition vm_table[N_STATES][EV_COUNT] = {
+    [COINS] = {
+        [EV_NEXT]     = { NULL, LIST },
+        [EV_PREV]     = { NULL, LIST },
+        [EV_SELECT]   = IGNORE,
+        [EV_RETURN]   = { vm_refund, COINS },
+        [EV_COIN_10]  = { vm_coin, COINS },
+        [EV_COIN_20]  = { vm_coin, COINS },
+        [EV_COIN_50]  = { vm_coin, COINS },
+        [EV_COIN_100] = { vm_coin, COINS },
+    },
+    [LIST] = {
+        [EV_NEXT]     = { vm_browse, LIST },
+        [EV_PREV]     = { vm_browse, LIST },
+        [EV_SELECT]   = { NULL, CHOOSE },
+        [EV_RETURN]   = { vm_refund_list, COINS },
+        [EV_COIN_10]  = { vm_coin_list, COINS },
+        [EV_COIN_20]  = { vm_coin_list, COINS },
+        [EV_COIN_50]  = { vm_coin_list, COINS },
+        [EV_COIN_100] = { vm_coin_list, COINS },
+    },
+    [CHOOSE] = {
+        [EV_NEXT]     = { vm_option, CHOOSE },
+        [EV_PREV]     = { vm_option, CHOOSE },
+        [EV_SELECT]   = { vm_buy, COINS },
+        [EV_RETURN]   = IGNORE,
+        [EV_COIN_10]  = { vm_coin_choose, CHOOSE },
+        [EV_COIN_20]  = { vm_coin_choose, CHOOSE },
+        [EV_COIN_50]  = { vm_coin_choose, CHOOSE },
+        [EV_COIN_100] = { vm_coin_choose, CHOOSE },
+    },
+};
+
+static const struct fsm_state vm_states[N_STATES] = {
+    [COINS]  = { NULL, NULL },
+    [LIST]   = { list_entry, NULL },
+    [CHOOSE] = { choose_entry, NULL },
+};
+
+static const struct fsm_def vm_fsm = { &vm_table[0][0], vm_states, N_STATES, EV_COUNT };
 /**
- * @param decpart Variable that permits to print the double format.
+ * @}
  */
-	int decpart = 0;
+
 
 /**
- * @param lista List of products and price.
+ *
+ *  @name   Main
+ *  @brief  Runs the state machine described by vm_table.
+ *          The thread sleeps on event_msgq and dispatches one event at a time.
+ *
  */
-	char lista[][40] = {"Coffee","Tuna sandwich","Beer","0.50","1.0","1.50"};
+
+void main(void)
+{
 
 /**
- * @param lista2 List with the type of products.
+ * @param ev Event being handled.
  */
-	char lista2[][40] = {"With Sugar","No Sugar","With Mayonese","No Mayonese","Superbock","Guinness"};
+	struct vm_event ev;
 
 /**
- * @param prices List with the price of the products.
+ * @param coin Coin taken from coin_ring.
  */
-	double prices[] = {0.50,1,1.50};
+	struct coin_event coin;
 
 /**
- * @param state Variable that indicates the first state.
+ * @param vm Credit and products on display.
  */
-	char STATE = COINS;
+	struct vm vm = { 0 };
 
 /**
- * @param  prod Variable that increments the product and price
+ * @param fsm State machine, starting in COINS.
  */
-	int prod = 0;
+	struct fsm fsm;
 
-  /**
- * @param k Variable to print list2.
- */
-	int extra;
-	
   /* Processing */  
   gpio0_dev = device_get_binding(DT_LABEL(GPIO0_NID));
+  coin_ring_init(&coin_ring);
   conf_buttons();
 	printk("\nVending machine just started\n\n");
-        
-
-		while (1) {                        
-                        /* States */                      
-                        switch(STATE){
-                                case COINS:
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                  if(f5 == 1){
-                                    credit += 0.1;
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                    printf("\33[2K\rcredit = %d.%d EUR", intpart, decpart);
-                                    STATE = COINS;
-                                    f5 = 0;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(f6 == 1){
-                                    credit += 0.2;
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                    printf("\33[2K\rcredit = %d.%d EUR", intpart, decpart);
-                                    STATE = COINS;
-                                    f6 = 0;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(f7 == 1){
-                                    credit += 0.5;
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                    printf("\33[2K\rcredit = %d.%d EUR", intpart, decpart);
-                                    STATE = COINS;
-                                    f7 = 0;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(f8 == 1){
-                                    credit += 1;
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                    printf("\33[2K\rcredit = %d.%d EUR", intpart, decpart);
-                                    STATE = COINS;
-                                    f8 = 0;
-                                    k_msleep(SLEEP);
-                                  } 
-                                  if((gpio_pin_get_dt(&button1) > 0) | (gpio_pin_get_dt(&button2) > 0)){
-                                    //printf("\n\nYour credit = %d.%d\n", intpart, decpart);
-                                    printf("\n\nProduct: %s - Price: %s EUR",lista[prod],lista[prod+3]);
-                                    STATE = LIST;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(gpio_pin_get_dt(&button4) > 0){
-                                    STATE = RETURN;
-                                  }
-                                  break;
-                                case LIST:
-                                  if((f5 == 1) | (f6 == 1) | (f7 == 1) | (f8 == 1))
-                                  {
-                                    printf("\n");
-                                    STATE = COINS;
-                                    f5 = 0; f6 = 0; f7 = 0; f8 = 0;
-                                  }
-                                  if(gpio_pin_get_dt(&button1) > 0){
-                                    prod++;
-                                    if(prod > 2)
-                                      prod = 0;
-                                    printf("\33[2K\rProduct: %s - Preco: %s EUR",lista[prod],lista[prod+3]);
-                                    STATE = LIST;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(gpio_pin_get_dt(&button2) > 0){
-                                    prod--;
-                                    if(prod < 0)
-                                      prod = 2;
-                                    printf("\33[2K\rProduct: %s - Preco: %s EUR",lista[prod],lista[prod+3]);
-                                    STATE = LIST;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(gpio_pin_get_dt(&button3) > 0)
-                                  {
-                                    if(lista[prod]==lista[0])
-                                    {
-                                      extra = 0;
-                                      printf("\n%s",lista2[extra]);
-                                    }
-                                    if(lista[prod]==lista[1])
-                                    {
-                                      extra = 2;
-                                      printf("\n%s",lista2[extra]);
-                                    }
-                                    if(lista[prod]==lista[2])
-                                    {
-                                      extra = 4;
-                                      printf("\n%s",lista2[extra]);
-                                    }
-                                    STATE = CHOOSE;
-                                    k_msleep(SLEEP);
-                                  }
-                                  if(gpio_pin_get_dt(&button4) > 0 && credit > 0){
-                                    STATE = RETURN;
-                                  }
-                                  break;
-                                case SELECT:
-                                  if(credit - prices[prod] < 0)
-                                  {
-                                    need = prices[prod] - credit;
-                                    int intpart2 = (int) need;
-                                    int decpart2 = (need - intpart2) * 10;
-                                    printf("\n\nInsuficient credit: %d.%d\n\nYou need more: %d.%d EUR\n",intpart,decpart,intpart2,decpart2);
-                                    STATE = COINS;
-                                    k_msleep(SLEEP);
-                                  }
-                                  else{
-                                    printf("\n\n%s selected\n",lista[prod]);
-                                    credit = credit - prices[prod];
-                                    intpart = (int) credit;
-                                    decpart = (credit - intpart) * 10;
-                                    STATE = RETURN;
-                                    k_msleep(SLEEP);
-                                  }
-                                  break;
-                                case RETURN:
-                                  if(credit <= 0)
-                                  {
-                                    credit = 0;
-                                    printf("\nNo credit to return\n\n");
-                                    k_msleep(200);
-                                    STATE = COINS;
-                                  }
-                                  if(credit > 0){
-                                    printf("\nCredit returned: %d.%d EUR\n\n",intpart,decpart);
-                                    credit = 0;
-                                    STATE = COINS;
-                                    k_msleep(SLEEP);
-                                  }
-                                  break;
-                                case CHOOSE:
-                                  if(lista[prod] == lista[0])
-                                  {
-                                    if((gpio_pin_get_dt(&button1) > 0) | (gpio_pin_get_dt(&button2) > 0))
-                                    {
-                                      extra++;
-                                      if(extra > 1)
-                                        extra = 0;
-                                      printf("\33[2K\r%s",lista2[extra]);
-                                      STATE = CHOOSE;
-                                      k_msleep(SLEEP);
-                                    }
-                                    else if(gpio_pin_get_dt(&button3) > 0)
-                                      STATE = SELECT;
-                                  }
-                                  if(lista[prod] == lista[1])
-                                  {
-                                    
-                                    if((gpio_pin_get_dt(&button1) > 0) | (gpio_pin_get_dt(&button2) > 0))
-                                    {
-                                      extra++;
-                                      if(extra > 3)
-                                        extra = 2;
-                                      printf("\33[2K\r%s",lista2[extra]);
-                                      STATE = CHOOSE;
-                                      k_msleep(SLEEP);
-                                    }
-                                    else if(gpio_pin_get_dt(&button3) > 0)
-                                      STATE = SELECT;
-                                  }
-                                  if(lista[prod] == lista[2])
-                                  {
-                                    if((gpio_pin_get_dt(&button1) > 0) | (gpio_pin_get_dt(&button2) > 0))
-                                    {
-                                      extra++;
-                                      if(extra > 5)
-                                        extra = 4;
-                                      printf("\33[2K\r%s",lista2[extra]);
-                                      STATE = CHOOSE;
-                                      k_msleep(SLEEP);
-                                    }
-                                    else if(gpio_pin_get_dt(&button3) > 0)
-                                      STATE = SELECT;
-                                  }
-                                  break;
-                        }
-			k_msleep(SLEEP_TIME_MS);
-		}
+
+    fsm_init(&fsm, &vm_fsm, COINS, &vm);
+
+    while (1) {
+        /* Sleeps until an input posts an event */
+        k_msgq_get(&event_msgq, &ev, K_FOREVER);
+
+        /* Every event drains the coins first, so a dropped doorbell loses nothing */
+        while (coin_ring_get(&coin_ring, &coin) == 0) {
+            fsm_dispatch(&fsm, EV_COIN_10 + coin.type);
+        }
+        if (ev.id != EV_COINS) {
+            fsm_dispatch(&fsm, ev.id);
+        }
+    }
 }
 
 /**
@@ -442,64 +495,26 @@ void conf_buttons()
 {
 
 /**
- * @param ret Variable that configure the input of the buttons.
+ * @param specs Buttons in event order: the development kit buttons, with their devicetree
+ *              flags, then the coins, active low with a pull-up.
  */
+const struct gpio_dt_spec specs[EV_COUNT] = {
+    button1, button2, button3, button4,
+    { .port = gpio0_dev, .pin = SW4_NODE, .dt_flags = GPIO_ACTIVE_LOW | GPIO_PULL_UP },
+    { .port = gpio0_dev, .pin = SW5_NODE, .dt_flags = GPIO_ACTIVE_LOW | GPIO_PULL_UP },
+    { .port = gpio0_dev, .pin = SW6_NODE, .dt_flags = GPIO_ACTIVE_LOW | GPIO_PULL_UP },
+    { .port = gpio0_dev, .pin = SW7_NODE, .dt_flags = GPIO_ACTIVE_LOW | GPIO_PULL_UP },
+};
 
+/**
+ * @param ret Variable that configure the input of the buttons.
+ */
 int ret;
 
-        // button 1
-	      ret = gpio_pin_configure_dt(&button1, GPIO_INPUT);
-	      ret = gpio_pin_interrupt_configure_dt(&button1, GPIO_INT_EDGE_TO_ACTIVE);
-
-	      gpio_init_callback(&button1_cb_data, button1_pressed, BIT(button1.pin));
-	      gpio_add_callback(button1.port, &button1_cb_data);
-
-        // button 2
-        ret = gpio_pin_configure_dt(&button2, GPIO_INPUT);
-	      ret = gpio_pin_interrupt_configure_dt(&button2, GPIO_INT_EDGE_TO_ACTIVE);
-
-	      gpio_init_callback(&button2_cb_data, button2_pressed, BIT(button2.pin));
-	      gpio_add_callback(button2.port, &button2_cb_data);
-
-        // button 3
-        ret = gpio_pin_configure_dt(&button3, GPIO_INPUT);
-	      ret = gpio_pin_interrupt_configure_dt(&button3, GPIO_INT_EDGE_TO_ACTIVE);
-
-	      gpio_init_callback(&button3_cb_data, button3_pressed, BIT(button3.pin));
-	      gpio_add_callback(button3.port, &button3_cb_data);
-
-        // button 4
-        ret = gpio_pin_configure_dt(&button4, GPIO_INPUT);
-	      ret = gpio_pin_interrupt_configure_dt(&button4, GPIO_INT_EDGE_TO_ACTIVE);
-
-	      gpio_init_callback(&button4_cb_data, button4_pressed, BIT(button4.pin));
-	      gpio_add_callback(button4.port, &button4_cb_data);
-
-        // button 5
-	      ret = gpio_pin_configure(gpio0_dev, SW4_NODE, GPIO_INPUT | GPIO_PULL_UP);
-        ret = gpio_pin_interrupt_configure(gpio0_dev, SW4_NODE, GPIO_INT_EDGE_TO_INACTIVE);
-
-        gpio_init_callback(&button5_cb_data, button5_pressed, BIT(SW4_NODE));
-        gpio_add_callback(gpio0_dev, &button5_cb_data);
-
-        // button 6
-	      ret = gpio_pin_configure(gpio0_dev, SW5_NODE, GPIO_INPUT | GPIO_PULL_UP);
-        ret = gpio_pin_interrupt_configure(gpio0_dev, SW5_NODE, GPIO_INT_EDGE_TO_INACTIVE);
-
-        gpio_init_callback(&button6_cb_data, button6_pressed, BIT(SW5_NODE));
-        gpio_add_callback(gpio0_dev, &button6_cb_data);
-
-        // button 7
-	      ret = gpio_pin_configure(gpio0_dev, SW6_NODE, GPIO_INPUT | GPIO_PULL_UP);
-        ret = gpio_pin_interrupt_configure(gpio0_dev, SW6_NODE, GPIO_INT_EDGE_TO_INACTIVE);
-
-        gpio_init_callback(&button7_cb_data, button7_pressed, BIT(SW6_NODE));
-        gpio_add_callback(gpio0_dev, &button7_cb_data);
-
-        // button 8
-	      ret = gpio_pin_configure(gpio0_dev, SW7_NODE, GPIO_INPUT | GPIO_PULL_UP);
-        ret = gpio_pin_interrupt_configure(gpio0_dev, SW7_NODE, GPIO_INT_EDGE_TO_INACTIVE);
-
-        gpio_init_callback(&button8_cb_data, button8_pressed, BIT(SW7_NODE));
-        gpio_add_callback(gpio0_dev, &button8_cb_data);
+        // one callback and one port read for all the buttons
+        ret = scanner_init(&scanner, specs, EV_COUNT,
+                           K_MSEC(DEBOUNCE_MS / SCANNER_SAMPLES), buttons_scanned);
+        if (ret < 0) {
+            printk("Error %d: failed to configure the buttons\n", ret);
+        }
 }
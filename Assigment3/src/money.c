@@ -0,0 +1,47 @@
+/**   @file money.c
+ *    @brief Money in integer cents
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#include "money.h"
+
+char *money_str(money_t amount, char *buf)
+{
+    static const char suffix[] = " EUR";
+    char digits[10];
+    char *p = buf;
+    uint32_t value, euros, cents;
+    int n = 0, i;
+
+    if (amount < 0) {
+        *p++ = '-';
+        value = -(uint32_t)amount;
+    }
+    else {
+        value = (uint32_t)amount;
+    }
+
+    euros = value / 100;
+    cents = value % 100;
+
+    /* Euros come out least significant digit first */
+    do {
+        digits[n++] = '0' + euros % 10;
+        euros /= 10;
+    } while (euros != 0);
+    while (n > 0) {
+        *p++ = digits[--n];
+    }
+
+    *p++ = '.';
+    *p++ = '0' + cents / 10;
+    *p++ = '0' + cents % 10;
+    for (i = 0; i < (int)sizeof(suffix); i++) {
+        *p++ = suffix[i];
+    }
+
+    return buf;
+}
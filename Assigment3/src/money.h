@@ -0,0 +1,41 @@
+/**   @file money.h
+ *    @brief Money in integer cents
+ *
+ *    Amounts are whole cents in an int32_t, so sums are exact and need no
+ *    floating point (the nRF52840 FPU is single precision only, so double
+ *    math would be done in software).
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <stdint.h>
+
+/**
+ * @{ @name   Money type
+ *    @brief  An amount in cents; EUR(1, 50) is 1.50 EUR.
+ */
+typedef int32_t money_t;
+
+#define EUR(euros, cents)   ((money_t)(euros) * 100 + (cents))
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Money formatter
+ *    @brief  money_str() writes amount as "E.CC EUR" in buf, which must have MONEY_STR_LEN
+ *            bytes, and returns buf. Only integer divisions by constants, no printf.
+ */
+#define MONEY_STR_LEN   20
+
+char *money_str(money_t amount, char *buf);
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,116 @@
+/**   @file scanner.c
+ *    @brief Port-wide input scanner
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <sys/__assert.h>
+#include "scanner.h"
+
+/* Any edge of the port (ISR context): starts a scan unless one is already due */
+static void scanner_edge(const struct device *dev, struct gpio_callback *cb, uint32_t pins)
+{
+    struct scanner *sc = CONTAINER_OF(cb, struct scanner, cb);
+
+    if (atomic_cas(&sc->scanning, 0, 1)) {
+        sc->edge_ts = k_uptime_get_32();
+    }
+    k_work_schedule(&sc->work, K_NO_WAIT);
+}
+
+static void scanner_scan(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct scanner *sc = CONTAINER_OF(dwork, struct scanner, work);
+    gpio_port_value_t raw;
+    uint8_t sample = 0;
+    uint8_t delta;
+    int i;
+
+    if (gpio_port_get_raw(sc->port, &raw) < 0) {
+        atomic_set(&sc->scanning, 0);
+        return;
+    }
+
+    /* Raw levels in input order, then flipped where a pressed input reads 0 */
+    for (i = 0; i < sc->n; i++) {
+        if (raw & BIT(sc->pin[i])) {
+            sample |= BIT(i);
+        }
+    }
+    sample ^= sc->active_low;
+
+    /*
+     * Each counter is reset to 3 while its input matches the debounced state
+     * and counts down otherwise; the inputs whose counter wraps have read
+     * the new level SCANNER_SAMPLES times in a row and toggle.
+     */
+    delta = sample ^ sc->state;
+    sc->ct0 = ~(sc->ct0 & delta);
+    sc->ct1 = sc->ct0 ^ (sc->ct1 & delta);
+    delta &= sc->ct0 & sc->ct1;
+    sc->state ^= delta;
+
+    if (delta) {
+        sc->handler(delta, sc->state, sc->edge_ts);
+    }
+
+    if (sample != sc->state) {
+        k_work_schedule(&sc->work, sc->period);
+    }
+    else {
+        atomic_set(&sc->scanning, 0);
+    }
+}
+
+int scanner_init(struct scanner *sc, const struct gpio_dt_spec *spec, uint8_t n,
+                 k_timeout_t period, scanner_handler_t handler)
+{
+    gpio_port_pins_t mask = 0;
+    int ret;
+    int i;
+
+    if (n == 0 || n > SCANNER_INPUTS || spec[0].port == NULL || handler == NULL) {
+        return -EINVAL;
+    }
+
+    /* One port read covers the inputs only if they are all on that port */
+    for (i = 1; i < n; i++) {
+        __ASSERT(spec[i].port == spec[0].port, "scanner: input %d is on another port", i);
+        if (spec[i].port != spec[0].port) {
+            return -EINVAL;
+        }
+    }
+
+    memset(sc, 0, sizeof(*sc));
+    sc->port = spec[0].port;
+    sc->n = n;
+    sc->period = period;
+    sc->handler = handler;
+    sc->ct0 = 0xff;
+    sc->ct1 = 0xff;
+    k_work_init_delayable(&sc->work, scanner_scan);
+
+    for (i = 0; i < n; i++) {
+        ret = gpio_pin_configure_dt(&spec[i], GPIO_INPUT);
+        if (ret < 0) {
+            return ret;
+        }
+        ret = gpio_pin_interrupt_configure_dt(&spec[i], GPIO_INT_EDGE_BOTH);
+        if (ret < 0) {
+            return ret;
+        }
+        sc->pin[i] = spec[i].pin;
+        if (spec[i].dt_flags & GPIO_ACTIVE_LOW) {
+            sc->active_low |= BIT(i);
+        }
+        mask |= BIT(spec[i].pin);
+    }
+
+    gpio_init_callback(&sc->cb, scanner_edge, mask);
+    return gpio_add_callback(sc->port, &sc->cb);
+}
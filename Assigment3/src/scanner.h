@@ -0,0 +1,77 @@
+/**   @file scanner.h
+ *    @brief Port-wide input scanner
+ *
+ *    Up to eight inputs of one GPIO port share a single callback. Each input
+ *    is given by its gpio_dt_spec, whose devicetree flags say if it is
+ *    active low and how it is pulled. An edge on any of them starts a
+ *    periodic scan that reads the whole port with one gpio_port_get_raw()
+ *    and debounces all the inputs at once with vertical counters: bit i of
+ *    each byte belongs to input i, so one XOR finds the inputs that differ
+ *    from their debounced state and a few logic operations count them. An input changes once it has been read
+ *    with the new level in SCANNER_SAMPLES scans in a row. The scan stops
+ *    when every input matches its debounced state.
+ *
+ *    @author Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date 7 May 2022
+ *    @bug No known bugs.
+ */
+
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <zephyr.h>
+#include <drivers/gpio.h>
+#include <sys/atomic.h>
+
+/**
+ * @{ @name   Scanner constants
+ *    @brief  Inputs per scanner (bits of the masks) and scans needed to accept a change.
+ */
+#define SCANNER_INPUTS  8
+#define SCANNER_SAMPLES 4
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Scanner structures
+ *    @brief  The handler gets the inputs that changed in one scan (edges) and the
+ *            debounced state of all of them, bit i set while input i is pressed, so
+ *            edges & state were pressed and edges & ~state released. It runs in the
+ *            system work queue, with the uptime (ms) of the first edge of the scan.
+ */
+typedef void (*scanner_handler_t)(uint8_t edges, uint8_t state, uint32_t timestamp);
+
+struct scanner {
+    const struct device *port;
+    gpio_pin_t pin[SCANNER_INPUTS];
+    uint8_t active_low;     /* bit i set if input i reads 0 when pressed */
+    uint8_t n;
+    k_timeout_t period;
+    scanner_handler_t handler;
+    struct gpio_callback cb;
+    struct k_work_delayable work;
+    uint8_t state;          /* debounced, bit i set while input i is pressed */
+    uint8_t ct0;            /* vertical counters, one 2-bit counter per input */
+    uint8_t ct1;
+    atomic_t scanning;      /* set from the first edge until the inputs settle */
+    uint32_t edge_ts;       /* first edge of the scan */
+};
+/**
+ * @}
+ */
+
+/**
+ * @{ @name   Scanner functions
+ *    @brief  scanner_init() configures the n inputs (n <= SCANNER_INPUTS) as inputs
+ *            interrupting on both edges, with the flags of their spec, spec[i] being
+ *            input i, and scans every period while they bounce. All the specs must
+ *            be on the same port. Returns 0 or a negative errno.
+ */
+int scanner_init(struct scanner *sc, const struct gpio_dt_spec *spec, uint8_t n,
+                 k_timeout_t period, scanner_handler_t handler);
+/**
+ * @}
+ */
+
+#endif
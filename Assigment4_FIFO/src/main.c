@@ -36,6 +36,7 @@
 #include <string.h>
 #include <drivers/gpio.h>
 #include <drivers/adc.h>
+#include "sample_fifo.h"
  /**
  * @}
  */
@@ -133,27 +134,16 @@ k_tid_t out_thread_tid;
  *    @brief        Creating FIFOS.
  *
  */
-struct k_fifo fifo_ab;
-struct k_fifo fifo_bc;
+#define FIFO_SIZE 16
+struct sample_fifo fifo_ab;
+struct sample_fifo fifo_bc;
+static uint16_t fifo_ab_buf[FIFO_SIZE];
+static uint16_t fifo_bc_buf[FIFO_SIZE];
 /**
 * @}
 */
 
 
-/**
- * @{ @addtogroup   Threads
- *    @name         FIFOS Structures and Variables
- *    @brief        Create fifo data structure and variable.
- *
- */
-struct data_item_t {
-    void *fifo_reserved;    /* 1st word reserved for use by FIFO */
-    uint16_t data;          /* Actual data */
-};
-/**
-* @}
-*/
-
 /**
  * @{ @addtogroup   Threads
  *    @name         Read Thread
@@ -382,8 +372,8 @@ void main(void)
      printk("\n\r IPC via FIFO \n\r");
     
     /* Create/Init fifos */
-    k_fifo_init(&fifo_ab);
-    k_fifo_init(&fifo_bc);
+    sample_fifo_init(&fifo_ab, fifo_ab_buf, FIFO_SIZE);
+    sample_fifo_init(&fifo_bc, fifo_bc_buf, FIFO_SIZE);
     
     /* Create tasks */
     read_thread_tid = k_thread_create(&read_thread_data, read_thread_stack,
@@ -475,7 +465,7 @@ void read_thread_code(void *argA , void *argB, void *argC)
     /* Timing variables to control task periodicity */
     int64_t fin_time=0, release_time=0;
 
-    struct data_item_t data_ab;
+    uint16_t data_ab = 0;
     
     printk("\nRead Thread init (periodic)\n");
 
@@ -497,12 +487,14 @@ void read_thread_code(void *argA , void *argB, void *argC)
             }
             else {
                 /* ADC is set to use gain of 1/4 and reference VDD/4, so input range is 0...VDD (3 V), with 10 bit resolution */
-                data_ab.data = (uint16_t)(1000*adc_sample_buffer[0]*((float)3/1023));
-                printk("adc reading: raw:%4u / %4u mV\n",adc_sample_buffer[0],data_ab.data);
+                data_ab = (uint16_t)(1000*adc_sample_buffer[0]*((float)3/1023));
+                printk("adc reading: raw:%4u / %4u mV\n",adc_sample_buffer[0],data_ab);
             }
         }
         
-        k_fifo_put(&fifo_ab, &data_ab);
+        if (sample_fifo_put(&fifo_ab, data_ab) != 0) {
+            printk("fifo_ab full, sample dropped\n");
+        }
 
        
         /* Wait for next release instant */ 
@@ -518,8 +510,8 @@ void read_thread_code(void *argA , void *argB, void *argC)
 void filter_thread_code(void *argA , void *argB, void *argC)
 {
 
-    struct data_item_t *data_ab;
-    struct data_item_t data_bc;
+    uint16_t data_ab;
+    uint16_t data_bc = 0;
 
     int dif1, dif2, sum1, sum2, average, i, k, j;
     int values_in[10] = {0,0,0,0,0,0,0,0,0,0};
@@ -528,7 +520,7 @@ void filter_thread_code(void *argA , void *argB, void *argC)
 
     while(1)
     {
-        data_ab = k_fifo_get(&fifo_ab, K_FOREVER);
+        sample_fifo_get(&fifo_ab, &data_ab, K_FOREVER);
        
         average = 0;
         sum1 = 0;
@@ -545,7 +537,7 @@ void filter_thread_code(void *argA , void *argB, void *argC)
               values_in[k] = values_in[k+1];
               // inserir valor lido na ultima posio do array
               if(k == 8)
-                values_in[k+1] = data_ab->data;
+                values_in[k+1] = data_ab;
             }
           }
           // Calcular soma dos valores do array
@@ -571,13 +563,15 @@ void filter_thread_code(void *argA , void *argB, void *argC)
             
             // if porque  impossivel dividir por 0
             if(j != 0)
-              data_bc.data = sum2 / j;
+              data_bc = sum2 / j;
           }
         }
 
-        printk("Filter Thread set the value to: %d \n",data_bc.data); 
+        printk("Filter Thread set the value to: %d \n",data_bc); 
          
-        k_fifo_put(&fifo_bc, &data_bc);
+        if (sample_fifo_put(&fifo_bc, data_bc) != 0) {
+            printk("fifo_bc full, sample dropped\n");
+        }
    
     }
 }
@@ -586,14 +580,14 @@ void out_thread_code(void *argA , void *argB, void *argC)
 {
     printk("\nOut Thread init\n");
     int out;
-    struct data_item_t *data_bc;
+    uint16_t data_bc;
 
     while(1)
     {
-        data_bc = k_fifo_get(&fifo_bc, K_FOREVER);
+        sample_fifo_get(&fifo_bc, &data_bc, K_FOREVER);
         ret = 0;
         // reclculo do valor
-        out = (uint16_t)(data_bc->data / ((float)3 / 1023) / 1000);
+        out = (uint16_t)(data_bc / ((float)3 / 1023) / 1000);
 
         ret = pwm_pin_set_usec(pwm0_dev, NLED1,
 		      pwmPeriod_us,(unsigned int)((pwmPeriod_us*out)/1023), PWM_POLARITY_NORMAL);
@@ -0,0 +1,69 @@
+/**   @file         sample_fifo.c
+ *    @brief        Fixed-capacity FIFO of uint16_t samples for one producer and one consumer
+ *
+ *                  No IRQ lock is taken: each index has a single writer and atomic_set()
+ *                  orders the write of the sample before the index update. k_sem_give()
+ *                  is ISR safe, so the producer may run in interrupt context.
+ *
+ *    @author       Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date         30 May 2022
+ *    @bug          No known bugs.
+ */
+
+#include <errno.h>
+#include "sample_fifo.h"
+
+int sample_fifo_init(struct sample_fifo *fifo, uint16_t *buf, uint32_t cap)
+{
+    if (buf == NULL || cap == 0 || (cap & (cap - 1)) != 0) {
+        return -EINVAL;
+    }
+
+    fifo->buf = buf;
+    fifo->mask = cap - 1;
+    atomic_set(&fifo->head, 0);
+    atomic_set(&fifo->tail, 0);
+
+    /* One count per stored sample, so it can never pass cap */
+    return k_sem_init(&fifo->sem, 0, cap);
+}
+
+/* Producer side: ISR or thread */
+int sample_fifo_put(struct sample_fifo *fifo, uint16_t value)
+{
+    uint32_t head = (uint32_t)atomic_get(&fifo->head);
+    uint32_t tail = (uint32_t)atomic_get(&fifo->tail);
+
+    if (head - tail > fifo->mask) {
+        return -ENOSPC;
+    }
+
+    fifo->buf[head & fifo->mask] = value;
+    atomic_set(&fifo->head, (atomic_val_t)(head + 1));
+    k_sem_give(&fifo->sem);
+    return 0;
+}
+
+/* Consumer side: thread only, since it may sleep */
+int sample_fifo_get(struct sample_fifo *fifo, uint16_t *value, k_timeout_t timeout)
+{
+    uint32_t tail;
+    int rc;
+
+    rc = k_sem_take(&fifo->sem, timeout);
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* The count taken above guarantees the sample at tail is published */
+    tail = (uint32_t)atomic_get(&fifo->tail);
+    *value = fifo->buf[tail & fifo->mask];
+    atomic_set(&fifo->tail, (atomic_val_t)(tail + 1));
+    return 0;
+}
+
+/* Either side; only a snapshot while the other side is running */
+uint32_t sample_fifo_size(struct sample_fifo *fifo)
+{
+    return (uint32_t)atomic_get(&fifo->head) - (uint32_t)atomic_get(&fifo->tail);
+}
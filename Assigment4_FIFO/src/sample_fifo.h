@@ -0,0 +1,53 @@
+/**   @file         sample_fifo.h
+ *    @brief        Fixed-capacity FIFO of uint16_t samples for one producer and one consumer
+ *
+ *                  Port of the Assignment1 MyFIFO ring to Zephyr. Samples are stored by
+ *                  value in a power-of-two array. The producer may be an ISR or a thread
+ *                  and never blocks; the consumer is a thread that sleeps on a k_sem
+ *                  until a sample is available.
+ *
+ *    @author       Rafael Fonseca, Gabriel Silva e Luis Almeida
+ *    @date         30 May 2022
+ *    @bug          No known bugs.
+ */
+
+#ifndef SAMPLE_FIFO_H
+#define SAMPLE_FIFO_H
+
+#include <zephyr.h>
+#include <sys/atomic.h>
+
+/**
+ * @{ @name         Sample FIFO Structure
+ *    @brief        head is only written by the producer and tail only by the consumer,
+ *                  both free running. sem counts the samples and only wakes the consumer.
+ *
+ */
+struct sample_fifo {
+    uint16_t *buf;
+    uint32_t mask;
+    atomic_t head;
+    atomic_t tail;
+    struct k_sem sem;
+};
+/**
+* @}
+*/
+
+/**
+ * @{ @name         Sample FIFO Functions
+ *    @brief        sample_fifo_init() takes storage of cap samples, cap a power of two.
+ *                  sample_fifo_put() is for the producer, from an ISR or a thread, and returns
+ *                  -ENOSPC when the FIFO is full. sample_fifo_get() is for the consumer thread
+ *                  and returns -EAGAIN if no sample arrives within timeout.
+ *
+ */
+int sample_fifo_init(struct sample_fifo *fifo, uint16_t *buf, uint32_t cap);
+int sample_fifo_put(struct sample_fifo *fifo, uint16_t value);
+int sample_fifo_get(struct sample_fifo *fifo, uint16_t *value, k_timeout_t timeout);
+uint32_t sample_fifo_size(struct sample_fifo *fifo);
+/**
+* @}
+*/
+
+#endif
@@ -1,5 +1,192 @@
-void MyFIFOInit();
-void MyFIFOInsert();
-void MyFIFORemove();
-void MyFIFOPeep();
-void MyFIFOSize();
\ No newline at end of file
+#ifndef MYFIFO_H
+#define MYFIFO_H
+
+#include <stddef.h>
+#include <string.h>
+#include "MyFIFOStats.h"
+
+/*
+ * MYFIFO_DECLARE(name, type) declares the queue type name_t and the
+ * nameInit/Insert/Remove/Peep/Size functions for elements of type.
+ * MYFIFO_DEFINE(name, type) generates the functions and must be used in
+ * exactly one .c file. The caller provides the storage, whose size must
+ * be a power of two.
+ *
+ * Besides single elements, the queue can be filled and drained in place:
+ * nameReserve() returns up to two writable spans (two when the space wraps
+ * around the end of the storage) that are published with nameCommit(), and
+ * namePeekSpan() returns the readable spans that are released with
+ * nameConsume(). namePushBulk()/namePopBulk() copy a whole batch with one
+ * memcpy per span and a single index update.
+ *
+ * Built with -DMYFIFO_STATS, each queue also keeps a MyFIFOStats_t that
+ * nameStats() returns; otherwise nameStats() returns -1 and the other
+ * functions are unchanged.
+ */
+#define MYFIFO_DECLARE(name, type)                                          \
+    typedef struct {                                                        \
+        type *buf;                                                          \
+        size_t mask;                                                        \
+        size_t head;    /* next position to write, never wrapped */         \
+        size_t tail;    /* oldest element, never wrapped */                 \
+        MYFIFO_STATS_FIELD(stats)                                           \
+    } name##_t;                                                             \
+                                                                            \
+    typedef struct {                                                        \
+        type *ptr[2];                                                       \
+        size_t len[2];                                                      \
+    } name##Span_t;                                                         \
+                                                                            \
+    int name##Init(name##_t *q, type *buf, size_t cap);                     \
+    int name##Insert(name##_t *q, type value);                              \
+    int name##Remove(name##_t *q, type *value);                             \
+    int name##Peep(name##_t *q, type *value);                               \
+    size_t name##Size(name##_t *q);                                         \
+    size_t name##Reserve(name##_t *q, size_t n, name##Span_t *span);        \
+    void name##Commit(name##_t *q, size_t n);                               \
+    size_t name##PeekSpan(name##_t *q, name##Span_t *span);                 \
+    void name##Consume(name##_t *q, size_t n);                              \
+    size_t name##PushBulk(name##_t *q, const type *src, size_t n);          \
+    size_t name##PopBulk(name##_t *q, type *dst, size_t n);                 \
+    int name##Stats(name##_t *q, MyFIFOStats_t *st);
+
+#define MYFIFO_DEFINE(name, type)                                           \
+    int name##Init(name##_t *q, type *buf, size_t cap)                      \
+    {                                                                       \
+        if (buf == NULL || cap == 0 || (cap & (cap - 1)) != 0)              \
+            return -1;                                                      \
+        q->buf = buf;                                                       \
+        q->mask = cap - 1;                                                  \
+        q->head = 0;                                                        \
+        q->tail = 0;                                                        \
+        MYFIFO_STATS_RESET(q->stats);                                       \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Insert(name##_t *q, type value)                               \
+    {                                                                       \
+        if (q->head - q->tail > q->mask)                                    \
+        {                                                                   \
+            MYFIFO_STAT_FULL(q->stats);                                     \
+            return -1;                                                      \
+        }                                                                   \
+        q->buf[q->head & q->mask] = value;                                  \
+        q->head++;                                                          \
+        MYFIFO_STAT_SIZE(q->stats, q->head - q->tail);                      \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Remove(name##_t *q, type *value)                              \
+    {                                                                       \
+        if (q->head == q->tail)                                             \
+        {                                                                   \
+            MYFIFO_STAT_EMPTY(q->stats);                                    \
+            return -1;                                                      \
+        }                                                                   \
+        if (value != NULL)                                                  \
+            *value = q->buf[q->tail & q->mask];                             \
+        q->tail++;                                                          \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Peep(name##_t *q, type *value)                                \
+    {                                                                       \
+        if (q->head == q->tail)                                             \
+            return -1;                                                      \
+        *value = q->buf[q->tail & q->mask];                                 \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    size_t name##Size(name##_t *q)                                          \
+    {                                                                       \
+        return q->head - q->tail;                                           \
+    }                                                                       \
+                                                                            \
+    /* Splits n elements starting at index pos into at most two spans */    \
+    static void name##Split(name##_t *q, size_t pos, size_t n,              \
+                            name##Span_t *span)                             \
+    {                                                                       \
+        size_t first = q->mask + 1 - (pos & q->mask);                       \
+                                                                            \
+        if (first > n)                                                      \
+            first = n;                                                      \
+        span->ptr[0] = q->buf + (pos & q->mask);                            \
+        span->len[0] = first;                                               \
+        span->ptr[1] = q->buf;                                              \
+        span->len[1] = n - first;                                           \
+    }                                                                       \
+                                                                            \
+    size_t name##Reserve(name##_t *q, size_t n, name##Span_t *span)         \
+    {                                                                       \
+        size_t room = q->mask + 1 - (q->head - q->tail);                    \
+                                                                            \
+        if (n > room)                                                       \
+            n = room;                                                       \
+        name##Split(q, q->head, n, span);                                   \
+        return n;                                                           \
+    }                                                                       \
+                                                                            \
+    void name##Commit(name##_t *q, size_t n)                                \
+    {                                                                       \
+        size_t room = q->mask + 1 - (q->head - q->tail);                    \
+                                                                            \
+        q->head += n < room ? n : room;                                     \
+        MYFIFO_STAT_SIZE(q->stats, q->head - q->tail);                      \
+    }                                                                       \
+                                                                            \
+    size_t name##PeekSpan(name##_t *q, name##Span_t *span)                  \
+    {                                                                       \
+        size_t n = q->head - q->tail;                                       \
+                                                                            \
+        name##Split(q, q->tail, n, span);                                   \
+        return n;                                                           \
+    }                                                                       \
+                                                                            \
+    void name##Consume(name##_t *q, size_t n)                               \
+    {                                                                       \
+        size_t used = q->head - q->tail;                                    \
+                                                                            \
+        q->tail += n < used ? n : used;                                     \
+    }                                                                       \
+                                                                            \
+    size_t name##PushBulk(name##_t *q, const type *src, size_t n)           \
+    {                                                                       \
+        name##Span_t span;                                                  \
+                                                                            \
+        size_t want = n;                                                    \
+                                                                            \
+        n = name##Reserve(q, n, &span);                                     \
+        if (n < want)                                                       \
+            MYFIFO_STAT_FULL(q->stats);                                     \
+        memcpy(span.ptr[0], src, span.len[0] * sizeof(type));               \
+        memcpy(span.ptr[1], src + span.len[0], span.len[1] * sizeof(type)); \
+        q->head += n;                                                       \
+        MYFIFO_STAT_SIZE(q->stats, q->head - q->tail);                      \
+        return n;                                                           \
+    }                                                                       \
+                                                                            \
+    size_t name##PopBulk(name##_t *q, type *dst, size_t n)                  \
+    {                                                                       \
+        size_t used = q->head - q->tail;                                    \
+        name##Span_t span;                                                  \
+                                                                            \
+        if (n > used)                                                       \
+        {                                                                   \
+            MYFIFO_STAT_EMPTY(q->stats);                                    \
+            n = used;                                                       \
+        }                                                                   \
+        name##Split(q, q->tail, n, &span);                                  \
+        memcpy(dst, span.ptr[0], span.len[0] * sizeof(type));               \
+        memcpy(dst + span.len[0], span.ptr[1], span.len[1] * sizeof(type)); \
+        q->tail += n;                                                       \
+        return n;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Stats(name##_t *q, MyFIFOStats_t *st)                         \
+    {                                                                       \
+        return MYFIFO_STATS_COPY(st, q->stats);                             \
+    }
+
+MYFIFO_DECLARE(MyFIFO, int)
+
+#endif
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "MyFIFOLossy.h"
+
+/* Stamp of a slot holding position pos; pos * 2 + 1 while it is written */
+#define STAMP(pos) ((pos) * 2 + 2)
+
+/* cap must be a power of two */
+int MyFIFOLossyInit(MyFIFOLossy_t *q, MyFIFOLossySlot_t *slots, size_t cap)
+{
+    size_t i;
+
+    if (slots == NULL || cap == 0 || (cap & (cap - 1)) != 0)
+        return -1;
+
+    for (i = 0; i < cap; i++)
+    {
+        atomic_init(&slots[i].seq, 0);
+        atomic_init(&slots[i].data, 0);
+    }
+
+    q->slots = slots;
+    q->mask = cap - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->dropped, 0);
+    return 0;
+}
+
+/* Writer side. Never waits and never looks at tail: losses are counted by the reader */
+void MyFIFOLossyInsert(MyFIFOLossy_t *q, int value)
+{
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    MyFIFOLossySlot_t *slot = &q->slots[pos & q->mask];
+
+    atomic_store_explicit(&slot->seq, STAMP(pos) - 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&slot->data, value, memory_order_relaxed);
+    atomic_store_explicit(&slot->seq, STAMP(pos), memory_order_release);
+    atomic_store_explicit(&q->head, pos + 1, memory_order_release);
+}
+
+/* Reader side */
+int MyFIFOLossyRemove(MyFIFOLossy_t *q, int *value)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    MyFIFOLossySlot_t *slot;
+    size_t head, seq;
+    int v;
+
+    for (;;)
+    {
+        head = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail == head)
+            break;
+
+        /* The writer lapped us: the oldest cap elements are all that is left */
+        if (head - tail > q->mask + 1)
+        {
+            atomic_fetch_add_explicit(&q->dropped, head - tail - (q->mask + 1), memory_order_relaxed);
+            tail = head - (q->mask + 1);
+        }
+
+        slot = &q->slots[tail & q->mask];
+        seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        v = atomic_load_explicit(&slot->data, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+
+        if (seq == STAMP(tail) && atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+        {
+            if (value != NULL)
+                *value = v;
+            atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+            return 0;
+        }
+
+        /* Overwritten while we were reading it */
+        atomic_fetch_add_explicit(&q->dropped, 1, memory_order_relaxed);
+        tail++;
+    }
+
+    atomic_store_explicit(&q->tail, tail, memory_order_release);
+    return -1;
+}
+
+/* Only a snapshot while the other side is running */
+size_t MyFIFOLossySize(MyFIFOLossy_t *q)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    return head - tail > q->mask + 1 ? q->mask + 1 : head - tail;
+}
+
+size_t MyFIFOLossyDropped(MyFIFOLossy_t *q)
+{
+    return atomic_load_explicit(&q->dropped, memory_order_relaxed);
+}
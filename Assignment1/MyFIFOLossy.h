@@ -0,0 +1,36 @@
+#ifndef MYFIFOLOSSY_H
+#define MYFIFOLOSSY_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "MyFIFOSpsc.h"
+
+/*
+ * Overwrite-oldest FIFO for one writer and one concurrent reader. The
+ * writer never waits: when the queue is full it reuses the oldest slot.
+ * Every slot carries a stamp of the position it holds (odd while it is
+ * being written), so the reader can tell when a slot was overwritten
+ * under it and skip ahead instead of returning a torn value.
+ */
+typedef struct {
+    atomic_size_t seq;
+    atomic_int data;
+} MyFIFOLossySlot_t;
+
+typedef struct {
+    _Alignas(MYFIFO_CACHE_LINE) MyFIFOLossySlot_t *slots;
+    size_t mask;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t head;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t tail;
+    atomic_size_t dropped;      /* elements the reader skipped */
+} MyFIFOLossy_t;
+
+int MyFIFOLossyInit(MyFIFOLossy_t *q, MyFIFOLossySlot_t *slots, size_t cap);
+void MyFIFOLossyInsert(MyFIFOLossy_t *q, int value);
+int MyFIFOLossyRemove(MyFIFOLossy_t *q, int *value);
+size_t MyFIFOLossySize(MyFIFOLossy_t *q);
+size_t MyFIFOLossyDropped(MyFIFOLossy_t *q);
+
+#endif
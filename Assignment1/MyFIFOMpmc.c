@@ -0,0 +1,90 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "MyFIFOMpmc.h"
+
+/* cap must be a power of two */
+int MyFIFOMpmcInit(MyFIFOMpmc_t *q, MyFIFOMpmcCell_t *cells, size_t cap)
+{
+    size_t i;
+
+    if (cells == NULL || cap < 2 || (cap & (cap - 1)) != 0)
+        return -1;
+
+    for (i = 0; i < cap; i++)
+        atomic_init(&cells[i].seq, i);
+
+    q->cells = cells;
+    q->mask = cap - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    return 0;
+}
+
+int MyFIFOMpmcInsert(MyFIFOMpmc_t *q, int value)
+{
+    size_t pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    MyFIFOMpmcCell_t *cell;
+    intptr_t dif;
+
+    for (;;)
+    {
+        cell = &q->cells[pos & q->mask];
+        dif = (intptr_t)atomic_load_explicit(&cell->seq, memory_order_acquire) - (intptr_t)pos;
+
+        if (dif == 0)
+        {
+            /* Cell is free for this lap: claim it */
+            if (atomic_compare_exchange_weak_explicit(&q->head, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (dif < 0)
+            return -1;  /* still holds the element from the previous lap: full */
+        else
+            pos = atomic_load_explicit(&q->head, memory_order_relaxed);
+    }
+
+    cell->data = value;
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+    return 0;
+}
+
+int MyFIFOMpmcRemove(MyFIFOMpmc_t *q, int *value)
+{
+    size_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    MyFIFOMpmcCell_t *cell;
+    intptr_t dif;
+
+    for (;;)
+    {
+        cell = &q->cells[pos & q->mask];
+        dif = (intptr_t)atomic_load_explicit(&cell->seq, memory_order_acquire) - (intptr_t)(pos + 1);
+
+        if (dif == 0)
+        {
+            if (atomic_compare_exchange_weak_explicit(&q->tail, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (dif < 0)
+            return -1;  /* not written yet: empty */
+        else
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    }
+
+    if (value != NULL)
+        *value = cell->data;
+    /* Free the cell for the next lap */
+    atomic_store_explicit(&cell->seq, pos + q->mask + 1, memory_order_release);
+    return 0;
+}
+
+/* Approximate while other threads are running */
+size_t MyFIFOMpmcSize(MyFIFOMpmc_t *q)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    return head > tail ? head - tail : 0;
+}
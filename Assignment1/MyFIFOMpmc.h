@@ -0,0 +1,33 @@
+#ifndef MYFIFOMPMC_H
+#define MYFIFOMPMC_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "MyFIFOSpsc.h"
+
+/*
+ * Bounded multi-producer/multi-consumer FIFO (Vyukov). Every cell has a
+ * sequence number telling whether it is ready to be written for lap n or
+ * read for lap n, so producers and consumers only contend on a CAS of
+ * head or tail, never on a lock.
+ */
+typedef struct {
+    atomic_size_t seq;
+    int data;
+} MyFIFOMpmcCell_t;
+
+typedef struct {
+    _Alignas(MYFIFO_CACHE_LINE) MyFIFOMpmcCell_t *cells;
+    size_t mask;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t head;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t tail;
+} MyFIFOMpmc_t;
+
+int MyFIFOMpmcInit(MyFIFOMpmc_t *q, MyFIFOMpmcCell_t *cells, size_t cap);
+int MyFIFOMpmcInsert(MyFIFOMpmc_t *q, int value);
+int MyFIFOMpmcRemove(MyFIFOMpmc_t *q, int *value);
+size_t MyFIFOMpmcSize(MyFIFOMpmc_t *q);
+
+#endif
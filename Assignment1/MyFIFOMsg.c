@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MyFIFOMsg.h"
+
+#define HDR sizeof(MyFIFOMsgHdr_t)
+#define RECORD(len) ((HDR + (len) + MYFIFO_MSG_ALIGN - 1) & ~(size_t)(MYFIFO_MSG_ALIGN - 1))
+
+/* buf must be MYFIFO_MSG_ALIGN aligned and cap a power of two */
+int MyFIFOMsgInit(MyFIFOMsg_t *q, void *buf, size_t cap)
+{
+    if (buf == NULL || cap < 2 * HDR || (cap & (cap - 1)) != 0
+        || ((uintptr_t)buf & (MYFIFO_MSG_ALIGN - 1)) != 0)
+        return -1;
+
+    q->buf = buf;
+    q->mask = cap - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->tail_cache = 0;
+    q->head_cache = 0;
+    q->reserve_pos = 0;
+    q->peek_next = 0;
+    return 0;
+}
+
+static MyFIFOMsgHdr_t *MyFIFOMsgHdrAt(MyFIFOMsg_t *q, size_t pos)
+{
+    return (MyFIFOMsgHdr_t *)(q->buf + (pos & q->mask));
+}
+
+/*
+ * Producer side. Returns len contiguous writable bytes, or NULL if there is
+ * no room. Nothing is visible to the consumer until MyFIFOMsgCommit().
+ */
+void *MyFIFOMsgReserve(MyFIFOMsg_t *q, size_t len)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t cap = q->mask + 1;
+    size_t to_end = cap - (head & q->mask);
+    size_t need = RECORD(len);
+    size_t pos = head;
+
+    /* Bigger records might never find a contiguous span, even in an empty FIFO */
+    if (len >= MYFIFO_MSG_SKIP || need > cap / 2)
+        return NULL;
+
+    /* Does not fit before the end: skip to offset 0 */
+    if (to_end < need)
+    {
+        pos = head + to_end;
+        need += to_end;
+    }
+
+    if (head - q->tail_cache + need > cap)
+    {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head - q->tail_cache + need > cap)
+            return NULL;
+    }
+
+    if (pos != head)
+        MyFIFOMsgHdrAt(q, head)->len = MYFIFO_MSG_SKIP;
+
+    q->reserve_pos = pos;
+    return MyFIFOMsgHdrAt(q, pos) + 1;
+}
+
+/* Producer side. Publishes the reserved record with len <= the reserved length */
+void MyFIFOMsgCommit(MyFIFOMsg_t *q, size_t len)
+{
+    MyFIFOMsgHdrAt(q, q->reserve_pos)->len = (uint32_t)len;
+    atomic_store_explicit(&q->head, q->reserve_pos + RECORD(len), memory_order_release);
+}
+
+int MyFIFOMsgWrite(MyFIFOMsg_t *q, const void *data, size_t len)
+{
+    void *p = MyFIFOMsgReserve(q, len);
+
+    if (p == NULL)
+        return -1;
+
+    memcpy(p, data, len);
+    MyFIFOMsgCommit(q, len);
+    return 0;
+}
+
+/*
+ * Consumer side. Returns the oldest message in place and its length, or
+ * NULL if the FIFO is empty. The message stays valid until MyFIFOMsgRelease().
+ */
+const void *MyFIFOMsgPeek(MyFIFOMsg_t *q, size_t *len)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    MyFIFOMsgHdr_t *hdr;
+
+    if (tail == q->head_cache)
+    {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail == q->head_cache)
+            return NULL;
+    }
+
+    hdr = MyFIFOMsgHdrAt(q, tail);
+    if (hdr->len == MYFIFO_MSG_SKIP)
+    {
+        /* A skip is always committed together with the record after it */
+        tail += q->mask + 1 - (tail & q->mask);
+        hdr = MyFIFOMsgHdrAt(q, tail);
+    }
+
+    q->peek_next = tail + RECORD(hdr->len);
+    *len = hdr->len;
+    return hdr + 1;
+}
+
+/* Consumer side. Frees the message returned by the last MyFIFOMsgPeek() */
+void MyFIFOMsgRelease(MyFIFOMsg_t *q)
+{
+    atomic_store_explicit(&q->tail, q->peek_next, memory_order_release);
+}
+
+/*
+ * Consumer side. Copies the oldest message into dst.
+ * Returns 0 on success, -1 if the FIFO is empty, -2 if the message is
+ * larger than max (it is left in the FIFO and *len tells its size).
+ */
+int MyFIFOMsgRead(MyFIFOMsg_t *q, void *dst, size_t max, size_t *len)
+{
+    const void *p = MyFIFOMsgPeek(q, len);
+
+    if (p == NULL)
+        return -1;
+    if (*len > max)
+        return -2;
+
+    memcpy(dst, p, *len);
+    MyFIFOMsgRelease(q);
+    return 0;
+}
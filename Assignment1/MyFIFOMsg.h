@@ -0,0 +1,45 @@
+#ifndef MYFIFOMSG_H
+#define MYFIFOMSG_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "MyFIFOSpsc.h"
+
+#define MYFIFO_MSG_ALIGN 8                  /* records and payloads are 8-byte aligned */
+#define MYFIFO_MSG_SKIP  UINT32_MAX         /* header length meaning "continue at offset 0" */
+
+/*
+ * Byte FIFO of variable-length messages for one producer and one consumer.
+ * Each record is an 8-byte header holding the payload length, followed by
+ * the payload, padded to MYFIFO_MSG_ALIGN. A record never wraps: when it
+ * does not fit before the end of the buffer, a skip header is written and
+ * the record starts at offset 0, so a message is always one contiguous span.
+ */
+typedef struct {
+    uint32_t len;
+    uint32_t reserved;
+} MyFIFOMsgHdr_t;
+
+typedef struct {
+    _Alignas(MYFIFO_CACHE_LINE) unsigned char *buf;
+    size_t mask;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t head;
+    size_t tail_cache;
+    size_t reserve_pos;     /* where the reserved record starts */
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t tail;
+    size_t head_cache;
+    size_t peek_next;       /* tail after the peeked record */
+} MyFIFOMsg_t;
+
+int MyFIFOMsgInit(MyFIFOMsg_t *q, void *buf, size_t cap);
+void *MyFIFOMsgReserve(MyFIFOMsg_t *q, size_t len);
+void MyFIFOMsgCommit(MyFIFOMsg_t *q, size_t len);
+int MyFIFOMsgWrite(MyFIFOMsg_t *q, const void *data, size_t len);
+const void *MyFIFOMsgPeek(MyFIFOMsg_t *q, size_t *len);
+void MyFIFOMsgRelease(MyFIFOMsg_t *q);
+int MyFIFOMsgRead(MyFIFOMsg_t *q, void *dst, size_t max, size_t *len);
+
+#endif
@@ -0,0 +1,5 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "MyFIFOPrio.h"
+
+MYFIFO_PRIO_DEFINE(MyFIFOPrio, int, 4)
@@ -0,0 +1,110 @@
+#ifndef MYFIFOPRIO_H
+#define MYFIFOPRIO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "MyFIFO.h"
+
+/*
+ * Priority FIFO with levels rings of the same capacity, one per priority,
+ * 0 being the most urgent. A bitmap has a bit set for every level that is
+ * not empty, so Remove takes the lowest set bit (one count-trailing-zeros
+ * instruction) and pops that ring: O(1), with no scan of the levels.
+ * Elements of the same level keep FIFO order.
+ *
+ * MYFIFO_PRIO_DECLARE(name, type, levels) declares name_t, the ring type
+ * nameRing_t and the functions; MYFIFO_PRIO_DEFINE(name, type, levels)
+ * generates them in one .c file. The storage has levels * cap elements,
+ * cap a power of two.
+ */
+#define MYFIFO_PRIO_DECLARE(name, type, levels)                             \
+    _Static_assert((levels) >= 1 && (levels) <= 32,                         \
+                   #name ": levels must be 1 to 32");                       \
+    MYFIFO_DECLARE(name##Ring, type)                                        \
+                                                                            \
+    typedef struct {                                                        \
+        name##Ring_t level[levels];                                         \
+        uint32_t ready;     /* bit p set while level p is not empty */      \
+    } name##_t;                                                             \
+                                                                            \
+    int name##Init(name##_t *q, type *buf, size_t cap);                     \
+    int name##Insert(name##_t *q, unsigned prio, type value);               \
+    int name##Remove(name##_t *q, type *value, unsigned *prio);             \
+    int name##Peep(name##_t *q, type *value, unsigned *prio);               \
+    size_t name##Size(name##_t *q);                                         \
+    size_t name##LevelSize(name##_t *q, unsigned prio);
+
+#define MYFIFO_PRIO_DEFINE(name, type, levels)                              \
+    MYFIFO_DEFINE(name##Ring, type)                                         \
+                                                                            \
+    int name##Init(name##_t *q, type *buf, size_t cap)                      \
+    {                                                                       \
+        unsigned p;                                                         \
+                                                                            \
+        for (p = 0; p < (levels); p++)                                      \
+        {                                                                   \
+            if (name##RingInit(&q->level[p], buf + p * cap, cap) != 0)      \
+                return -1;                                                  \
+        }                                                                   \
+        q->ready = 0;                                                       \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Insert(name##_t *q, unsigned prio, type value)                \
+    {                                                                       \
+        if (prio >= (levels))                                               \
+            return -1;                                                      \
+        if (name##RingInsert(&q->level[prio], value) != 0)                  \
+            return -1;                                                      \
+        q->ready |= (uint32_t)1 << prio;                                    \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Remove(name##_t *q, type *value, unsigned *prio)              \
+    {                                                                       \
+        unsigned p;                                                         \
+                                                                            \
+        if (q->ready == 0)                                                  \
+            return -1;                                                      \
+        p = __builtin_ctz(q->ready);                                        \
+        name##RingRemove(&q->level[p], value);                              \
+        if (name##RingSize(&q->level[p]) == 0)                              \
+            q->ready &= ~((uint32_t)1 << p);                                \
+        if (prio != NULL)                                                   \
+            *prio = p;                                                      \
+        return 0;                                                           \
+    }                                                                       \
+                                                                            \
+    int name##Peep(name##_t *q, type *value, unsigned *prio)                \
+    {                                                                       \
+        unsigned p;                                                         \
+                                                                            \
+        if (q->ready == 0)                                                  \
+            return -1;                                                      \
+        p = __builtin_ctz(q->ready);                                        \
+        if (prio != NULL)                                                   \
+            *prio = p;                                                      \
+        return name##RingPeep(&q->level[p], value);                         \
+    }                                                                       \
+                                                                            \
+    size_t name##Size(name##_t *q)                                          \
+    {                                                                       \
+        uint32_t ready = q->ready;                                          \
+        size_t n = 0;                                                       \
+                                                                            \
+        while (ready != 0)                                                  \
+        {                                                                   \
+            n += name##RingSize(&q->level[__builtin_ctz(ready)]);           \
+            ready &= ready - 1;                                             \
+        }                                                                   \
+        return n;                                                           \
+    }                                                                       \
+                                                                            \
+    size_t name##LevelSize(name##_t *q, unsigned prio)                      \
+    {                                                                       \
+        return prio < (levels) ? name##RingSize(&q->level[prio]) : 0;       \
+    }
+
+MYFIFO_PRIO_DECLARE(MyFIFOPrio, int, 4)
+
+#endif
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "MyFIFOShm.h"
+
+#define DATA_OFFSET ((sizeof(MyFIFOShmHdr_t) + MYFIFO_CACHE_LINE - 1) & ~(size_t)(MYFIFO_CACHE_LINE - 1))
+
+/* Shared (not private) futexes, since the waiters are in other processes */
+static void MyFIFOShmPark(_Atomic uint32_t *flag)
+{
+#ifdef __linux__
+    syscall(SYS_futex, flag, FUTEX_WAIT, 1, NULL, NULL, 0);
+#else
+    sched_yield();
+#endif
+}
+
+static void MyFIFOShmUnpark(_Atomic uint32_t *flag)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(flag, memory_order_relaxed) == 0)
+        return;
+    if (atomic_exchange(flag, 0) == 0)
+        return;
+#ifdef __linux__
+    syscall(SYS_futex, flag, FUTEX_WAKE, 1, NULL, NULL, 0);
+#endif
+}
+
+/* Maps bytes of fd; the caller still owns fd and closes it */
+static int MyFIFOShmMap(MyFIFOShm_t *q, int fd, size_t bytes)
+{
+    void *p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (p == MAP_FAILED)
+        return -1;
+
+    q->hdr = p;
+    q->bytes = bytes;
+    return 0;
+}
+
+/* Creates the segment /name for cap ints (a power of two). Fails if it exists */
+int MyFIFOShmCreate(MyFIFOShm_t *q, const char *name, size_t cap)
+{
+    size_t bytes = DATA_OFFSET + cap * sizeof(int);
+    MyFIFOShmHdr_t *hdr;
+    int fd;
+
+    if (cap == 0 || (cap & (cap - 1)) != 0)
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return -1;
+
+    if (ftruncate(fd, bytes) < 0 || MyFIFOShmMap(q, fd, bytes) < 0)
+    {
+        close(fd);
+        shm_unlink(name);
+        return -1;
+    }
+    close(fd);
+
+    hdr = q->hdr;
+    hdr->version = MYFIFO_SHM_VERSION;
+    hdr->capacity = cap;
+    hdr->elem_size = sizeof(int);
+    hdr->data_offset = DATA_OFFSET;
+    atomic_init(&hdr->head, 0);
+    atomic_init(&hdr->tail, 0);
+    atomic_init(&hdr->cons_wait, 0);
+    atomic_init(&hdr->prod_wait, 0);
+    q->tail_cache = 0;
+    q->head_cache = 0;
+
+    /* The magic goes last: an opener that sees it sees a complete header */
+    atomic_store_explicit((_Atomic uint32_t *)&hdr->magic, MYFIFO_SHM_MAGIC, memory_order_release);
+
+    q->data = (int *)((char *)hdr + hdr->data_offset);
+    q->mask = cap - 1;
+    return 0;
+}
+
+/* Maps an existing segment, checking that its layout is the one we expect */
+int MyFIFOShmOpen(MyFIFOShm_t *q, const char *name)
+{
+    struct stat sb;
+    MyFIFOShmHdr_t *hdr;
+    int fd;
+
+    fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0)
+        return -1;
+
+    if (fstat(fd, &sb) < 0 || (size_t)sb.st_size < DATA_OFFSET || MyFIFOShmMap(q, fd, sb.st_size) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+    close(fd);
+
+    hdr = q->hdr;
+    if (atomic_load_explicit((_Atomic uint32_t *)&hdr->magic, memory_order_acquire) != MYFIFO_SHM_MAGIC
+        || hdr->version != MYFIFO_SHM_VERSION || hdr->elem_size != sizeof(int)
+        || hdr->capacity == 0 || (hdr->capacity & (hdr->capacity - 1)) != 0
+        || hdr->data_offset + hdr->capacity * sizeof(int) > q->bytes)
+    {
+        MyFIFOShmClose(q);
+        errno = EPROTO;
+        return -1;
+    }
+
+    /* The queue may have been used before: start the caches at its indexes */
+    q->tail_cache = atomic_load_explicit(&hdr->tail, memory_order_acquire);
+    q->head_cache = atomic_load_explicit(&hdr->head, memory_order_acquire);
+    q->data = (int *)((char *)hdr + hdr->data_offset);
+    q->mask = hdr->capacity - 1;
+    return 0;
+}
+
+void MyFIFOShmClose(MyFIFOShm_t *q)
+{
+    if (q->hdr != NULL)
+        munmap(q->hdr, q->bytes);
+    q->hdr = NULL;
+}
+
+int MyFIFOShmUnlink(const char *name)
+{
+    return shm_unlink(name);
+}
+
+/* Producer side */
+int MyFIFOShmInsert(MyFIFOShm_t *q, int value)
+{
+    uint64_t head = atomic_load_explicit(&q->hdr->head, memory_order_relaxed);
+
+    if (head - q->tail_cache > q->mask)
+    {
+        q->tail_cache = atomic_load_explicit(&q->hdr->tail, memory_order_acquire);
+        if (head - q->tail_cache > q->mask)
+            return -1;
+    }
+
+    q->data[head & q->mask] = value;
+    atomic_store_explicit(&q->hdr->head, head + 1, memory_order_release);
+    return 0;
+}
+
+/* Consumer side */
+int MyFIFOShmRemove(MyFIFOShm_t *q, int *value)
+{
+    uint64_t tail = atomic_load_explicit(&q->hdr->tail, memory_order_relaxed);
+
+    if (tail == q->head_cache)
+    {
+        q->head_cache = atomic_load_explicit(&q->hdr->head, memory_order_acquire);
+        if (tail == q->head_cache)
+            return -1;
+    }
+
+    if (value != NULL)
+        *value = q->data[tail & q->mask];
+    atomic_store_explicit(&q->hdr->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+/* Blocking mode, as in MyFIFOSpscInsertWait(): both sides must use it */
+void MyFIFOShmInsertWait(MyFIFOShm_t *q, int value)
+{
+    int spin = 0;
+
+    while (MyFIFOShmInsert(q, value) != 0)
+    {
+        if (spin++ < MYFIFO_SPIN)
+        {
+            MyFIFOCpuRelax();
+            continue;
+        }
+
+        atomic_store(&q->hdr->prod_wait, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (MyFIFOShmInsert(q, value) == 0)
+        {
+            atomic_store(&q->hdr->prod_wait, 0);
+            break;
+        }
+        MyFIFOShmPark(&q->hdr->prod_wait);
+    }
+
+    MyFIFOShmUnpark(&q->hdr->cons_wait);
+}
+
+void MyFIFOShmRemoveWait(MyFIFOShm_t *q, int *value)
+{
+    int spin = 0;
+
+    while (MyFIFOShmRemove(q, value) != 0)
+    {
+        if (spin++ < MYFIFO_SPIN)
+        {
+            MyFIFOCpuRelax();
+            continue;
+        }
+
+        atomic_store(&q->hdr->cons_wait, 1);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (MyFIFOShmRemove(q, value) == 0)
+        {
+            atomic_store(&q->hdr->cons_wait, 0);
+            break;
+        }
+        MyFIFOShmPark(&q->hdr->cons_wait);
+    }
+
+    MyFIFOShmUnpark(&q->hdr->prod_wait);
+}
+
+/* Only a snapshot while the other side is running */
+size_t MyFIFOShmSize(MyFIFOShm_t *q)
+{
+    uint64_t tail = atomic_load_explicit(&q->hdr->tail, memory_order_acquire);
+    uint64_t head = atomic_load_explicit(&q->hdr->head, memory_order_acquire);
+
+    return head - tail;
+}
@@ -0,0 +1,53 @@
+#ifndef MYFIFOSHM_H
+#define MYFIFOSHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "MyFIFOSpsc.h"
+
+#define MYFIFO_SHM_MAGIC   0x4F464946u     /* "FIFO" */
+#define MYFIFO_SHM_VERSION 1
+
+/*
+ * Layout at the start of the shared memory segment. It holds no pointers,
+ * only fixed-size fields and the offset of the data, so every process can
+ * map the segment at a different address. head and tail are free-running
+ * element counts; the wait words are futexes shared between processes.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;      /* elements, a power of two */
+    uint64_t elem_size;
+    uint64_t data_offset;   /* bytes from the start of the segment */
+
+    _Alignas(MYFIFO_CACHE_LINE) _Atomic uint64_t head;
+
+    _Alignas(MYFIFO_CACHE_LINE) _Atomic uint64_t tail;
+
+    _Alignas(MYFIFO_CACHE_LINE) _Atomic uint32_t cons_wait;
+    _Atomic uint32_t prod_wait;
+} MyFIFOShmHdr_t;
+
+/* Per-process handle */
+typedef struct {
+    MyFIFOShmHdr_t *hdr;
+    int *data;
+    uint64_t mask;
+    size_t bytes;
+    uint64_t tail_cache;    /* producer's copy of tail */
+    uint64_t head_cache;    /* consumer's copy of head */
+} MyFIFOShm_t;
+
+int MyFIFOShmCreate(MyFIFOShm_t *q, const char *name, size_t cap);
+int MyFIFOShmOpen(MyFIFOShm_t *q, const char *name);
+void MyFIFOShmClose(MyFIFOShm_t *q);
+int MyFIFOShmUnlink(const char *name);
+int MyFIFOShmInsert(MyFIFOShm_t *q, int value);
+int MyFIFOShmRemove(MyFIFOShm_t *q, int *value);
+void MyFIFOShmInsertWait(MyFIFOShm_t *q, int value);
+void MyFIFOShmRemoveWait(MyFIFOShm_t *q, int *value);
+size_t MyFIFOShmSize(MyFIFOShm_t *q);
+
+#endif
@@ -0,0 +1,321 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "MyFIFOSpsc.h"
+
+static void MyFIFOWaitInit(MyFIFOWait_t *w)
+{
+    atomic_init(&w->flag, 0);
+#ifndef __linux__
+    pthread_mutex_init(&w->lock, NULL);
+    pthread_cond_init(&w->cond, NULL);
+#endif
+}
+
+/* Sleeps while w->flag is still 1; may return early */
+static void MyFIFOPark(MyFIFOWait_t *w)
+{
+#ifdef __linux__
+    syscall(SYS_futex, &w->flag, FUTEX_WAIT_PRIVATE, 1, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&w->lock);
+    while (atomic_load(&w->flag) == 1)
+        pthread_cond_wait(&w->cond, &w->lock);
+    pthread_mutex_unlock(&w->lock);
+#endif
+}
+
+/*
+ * Wakes the other side only if it announced it is parking, so there is no
+ * system call while both sides are running. Must follow the index update
+ * with a full fence, pairing with the fence in MyFIFOSpscPrepark().
+ */
+static void MyFIFOUnpark(MyFIFOWait_t *w)
+{
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&w->flag, memory_order_relaxed) == 0)
+        return;
+    if (atomic_exchange(&w->flag, 0) == 0)
+        return;
+#ifdef __linux__
+    syscall(SYS_futex, &w->flag, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+    pthread_mutex_lock(&w->lock);
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&w->lock);
+#endif
+}
+
+static void MyFIFOSpscPrepark(MyFIFOWait_t *w)
+{
+    atomic_store(&w->flag, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* cap must be a power of two */
+int MyFIFOSpscInit(MyFIFOSpsc_t *q, int *buf, size_t cap)
+{
+    if (buf == NULL || cap == 0 || (cap & (cap - 1)) != 0)
+        return -1;
+
+    q->buf = buf;
+    q->mask = cap - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    q->tail_cache = 0;
+    q->head_cache = 0;
+    MyFIFOWaitInit(&q->cons_wait);
+    MyFIFOWaitInit(&q->prod_wait);
+    MYFIFO_STATS_RESET(q->prod_stats);
+    MYFIFO_STATS_RESET(q->cons_stats);
+    return 0;
+}
+
+/* Elements in the FIFO, from the producer; only read for the stats */
+static inline size_t MyFIFOSpscUsed(MyFIFOSpsc_t *q)
+{
+    return atomic_load_explicit(&q->head, memory_order_relaxed)
+        - atomic_load_explicit(&q->tail, memory_order_relaxed);
+}
+
+/* Insert and Remove without the stats, for the Wait functions */
+static inline int MyFIFOSpscPut(MyFIFOSpsc_t *q, int value)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+
+    if (head - q->tail_cache > q->mask)
+    {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        if (head - q->tail_cache > q->mask)
+            return -1;
+    }
+
+    q->buf[head & q->mask] = value;
+    atomic_store_explicit(&q->head, head + 1, memory_order_release);
+    return 0;
+}
+
+static inline int MyFIFOSpscTake(MyFIFOSpsc_t *q, int *value)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (tail == q->head_cache)
+    {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail == q->head_cache)
+            return -1;
+    }
+
+    if (value != NULL)
+        *value = q->buf[tail & q->mask];
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+    return 0;
+}
+
+/* Producer side */
+int MyFIFOSpscInsert(MyFIFOSpsc_t *q, int value)
+{
+    if (MyFIFOSpscPut(q, value) != 0)
+    {
+        MYFIFO_STAT_FULL(q->prod_stats);
+        return -1;
+    }
+    MYFIFO_STAT_SIZE(q->prod_stats, MyFIFOSpscUsed(q));
+    return 0;
+}
+
+/* Consumer side */
+int MyFIFOSpscRemove(MyFIFOSpsc_t *q, int *value)
+{
+    if (MyFIFOSpscTake(q, value) != 0)
+    {
+        MYFIFO_STAT_EMPTY(q->cons_stats);
+        return -1;
+    }
+    return 0;
+}
+
+/* Consumer side */
+int MyFIFOSpscPeep(MyFIFOSpsc_t *q, int *value)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (tail == q->head_cache)
+    {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        if (tail == q->head_cache)
+            return -1;
+    }
+
+    *value = q->buf[tail & q->mask];
+    return 0;
+}
+
+/* Either side; only a snapshot while the other side is running */
+size_t MyFIFOSpscSize(MyFIFOSpsc_t *q)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+
+    return head - tail;
+}
+
+/* Copies src[] into slots pos..pos+n-1, wrapping at the end of the storage */
+static void MyFIFOSpscCopyIn(MyFIFOSpsc_t *q, size_t pos, const int *src, size_t n)
+{
+    size_t first = q->mask + 1 - (pos & q->mask);
+
+    if (first > n)
+        first = n;
+    memcpy(q->buf + (pos & q->mask), src, first * sizeof(int));
+    memcpy(q->buf, src + first, (n - first) * sizeof(int));
+}
+
+static void MyFIFOSpscCopyOut(MyFIFOSpsc_t *q, size_t pos, int *dst, size_t n)
+{
+    size_t first = q->mask + 1 - (pos & q->mask);
+
+    if (first > n)
+        first = n;
+    memcpy(dst, q->buf + (pos & q->mask), first * sizeof(int));
+    memcpy(dst + first, q->buf, (n - first) * sizeof(int));
+}
+
+/* Producer side. Inserts up to n elements with a single release of head */
+size_t MyFIFOSpscPushBulk(MyFIFOSpsc_t *q, const int *src, size_t n)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t room = q->mask + 1 - (head - q->tail_cache);
+
+    if (room < n)
+    {
+        q->tail_cache = atomic_load_explicit(&q->tail, memory_order_acquire);
+        room = q->mask + 1 - (head - q->tail_cache);
+        if (n > room)
+        {
+            MYFIFO_STAT_FULL(q->prod_stats);
+            n = room;
+        }
+    }
+
+    MyFIFOSpscCopyIn(q, head, src, n);
+    atomic_store_explicit(&q->head, head + n, memory_order_release);
+    MYFIFO_STAT_SIZE(q->prod_stats, MyFIFOSpscUsed(q));
+    return n;
+}
+
+/* Consumer side. Removes up to n elements with a single release of tail */
+size_t MyFIFOSpscPopBulk(MyFIFOSpsc_t *q, int *dst, size_t n)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t used = q->head_cache - tail;
+
+    if (used < n)
+    {
+        q->head_cache = atomic_load_explicit(&q->head, memory_order_acquire);
+        used = q->head_cache - tail;
+        if (n > used)
+        {
+            MYFIFO_STAT_EMPTY(q->cons_stats);
+            n = used;
+        }
+    }
+
+    MyFIFOSpscCopyOut(q, tail, dst, n);
+    atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+    return n;
+}
+
+/*
+ * Blocking mode. Both sides must use the Wait functions, since they are
+ * the ones that wake the other side. A full queue (producer) or an empty
+ * one (consumer) is polled MYFIFO_SPIN times before the caller parks.
+ * With stats, a call that has to wait counts once as full (empty) and the
+ * time until it succeeds is added to wait_ns.
+ */
+void MyFIFOSpscInsertWait(MyFIFOSpsc_t *q, int value)
+{
+    int spin = 0;
+
+    if (MyFIFOSpscPut(q, value) != 0)
+    {
+        MYFIFO_STAT_CLOCK(t0);
+
+        MYFIFO_STAT_FULL(q->prod_stats);
+        while (MyFIFOSpscPut(q, value) != 0)
+        {
+            if (spin < MYFIFO_SPIN)
+            {
+                spin++;
+                MyFIFOCpuRelax();
+                continue;
+            }
+
+            /* Announce, then check again so a Remove in between is not missed */
+            MyFIFOSpscPrepark(&q->prod_wait);
+            if (MyFIFOSpscPut(q, value) == 0)
+            {
+                atomic_store(&q->prod_wait.flag, 0);
+                break;
+            }
+            MyFIFOPark(&q->prod_wait);
+        }
+        MYFIFO_STAT_WAIT(q->prod_stats, t0);
+    }
+
+    MYFIFO_STAT_SIZE(q->prod_stats, MyFIFOSpscUsed(q));
+    MyFIFOUnpark(&q->cons_wait);
+}
+
+void MyFIFOSpscRemoveWait(MyFIFOSpsc_t *q, int *value)
+{
+    int spin = 0;
+
+    if (MyFIFOSpscTake(q, value) != 0)
+    {
+        MYFIFO_STAT_CLOCK(t0);
+
+        MYFIFO_STAT_EMPTY(q->cons_stats);
+        while (MyFIFOSpscTake(q, value) != 0)
+        {
+            if (spin < MYFIFO_SPIN)
+            {
+                spin++;
+                MyFIFOCpuRelax();
+                continue;
+            }
+
+            MyFIFOSpscPrepark(&q->cons_wait);
+            if (MyFIFOSpscTake(q, value) == 0)
+            {
+                atomic_store(&q->cons_wait.flag, 0);
+                break;
+            }
+            MyFIFOPark(&q->cons_wait);
+        }
+        MYFIFO_STAT_WAIT(q->cons_stats, t0);
+    }
+
+    MyFIFOUnpark(&q->prod_wait);
+}
+
+/*
+ * Both sides' counters together. Each side only updates its own block, so
+ * this is exact once both are idle and a snapshot while they run.
+ */
+int MyFIFOSpscStats(MyFIFOSpsc_t *q, MyFIFOStats_t *st)
+{
+#ifdef MYFIFO_STATS
+    *st = q->prod_stats;
+    MyFIFOStatsAdd(st, &q->cons_stats);
+    return 0;
+#else
+    memset(st, 0, sizeof(*st));
+    return -1;
+#endif
+}
@@ -0,0 +1,67 @@
+#ifndef MYFIFOSPSC_H
+#define MYFIFOSPSC_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "MyFIFOStats.h"
+#ifndef __linux__
+#include <pthread.h>
+#endif
+
+#define MYFIFO_CACHE_LINE 64
+#define MYFIFO_SPIN       1024  /* polls before a blocking call parks */
+
+/* A side parked on a futex (Linux) or condition variable while flag is 1 */
+typedef struct {
+    atomic_uint flag;
+#ifndef __linux__
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+} MyFIFOWait_t;
+
+/* Spin-wait hint, shared by the blocking modes */
+static inline void MyFIFOCpuRelax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield");
+#endif
+}
+
+/*
+ * Single-producer/single-consumer FIFO. Head is written only by the
+ * producer and tail only by the consumer, each on its own cache line.
+ * Each side keeps a private copy of the other side's index and only
+ * reloads it when the queue looks full (producer) or empty (consumer).
+ */
+typedef struct {
+    _Alignas(MYFIFO_CACHE_LINE) int *buf;
+    size_t mask;
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t head;
+    size_t tail_cache;
+    MYFIFO_STATS_FIELD(prod_stats)  /* each side counts on its own line */
+
+    _Alignas(MYFIFO_CACHE_LINE) atomic_size_t tail;
+    size_t head_cache;
+    MYFIFO_STATS_FIELD(cons_stats)
+
+    /* Only written when a side parks, so it stays cached by the other side */
+    _Alignas(MYFIFO_CACHE_LINE) MyFIFOWait_t cons_wait;
+    MyFIFOWait_t prod_wait;
+} MyFIFOSpsc_t;
+
+int MyFIFOSpscInit(MyFIFOSpsc_t *q, int *buf, size_t cap);
+int MyFIFOSpscInsert(MyFIFOSpsc_t *q, int value);
+int MyFIFOSpscRemove(MyFIFOSpsc_t *q, int *value);
+int MyFIFOSpscPeep(MyFIFOSpsc_t *q, int *value);
+size_t MyFIFOSpscSize(MyFIFOSpsc_t *q);
+size_t MyFIFOSpscPushBulk(MyFIFOSpsc_t *q, const int *src, size_t n);
+size_t MyFIFOSpscPopBulk(MyFIFOSpsc_t *q, int *dst, size_t n);
+void MyFIFOSpscInsertWait(MyFIFOSpsc_t *q, int value);
+void MyFIFOSpscRemoveWait(MyFIFOSpsc_t *q, int *value);
+int MyFIFOSpscStats(MyFIFOSpsc_t *q, MyFIFOStats_t *st);
+
+#endif
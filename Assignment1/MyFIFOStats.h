@@ -0,0 +1,84 @@
+#ifndef MYFIFOSTATS_H
+#define MYFIFOSTATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MYFIFO_STATS_BUCKETS 32
+
+/*
+ * Occupancy counters, compiled in with -DMYFIFO_STATS. hist[b] counts the
+ * inserts that left b-bit occupancy in the FIFO: hist[1] one element,
+ * hist[2] two or three, hist[3] four to seven and so on. Bulk inserts
+ * count once. wait_ns and waits are only updated by the blocking mode.
+ */
+typedef struct {
+    size_t high_water;      /* most elements ever in the FIFO */
+    size_t full;            /* inserts that found the FIFO full (bulk: short of room) */
+    size_t empty;           /* removes that found the FIFO empty (bulk: short of elements) */
+    size_t hist[MYFIFO_STATS_BUCKETS];
+    uint64_t wait_ns;       /* time blocked in the Wait functions */
+    size_t waits;           /* Wait calls that had to block */
+} MyFIFOStats_t;
+
+#ifdef MYFIFO_STATS
+
+#include <time.h>
+
+static inline uint64_t MyFIFOStatsNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static inline void MyFIFOStatsSize(MyFIFOStats_t *s, size_t n)
+{
+    size_t b = n == 0 ? 0 : sizeof(long) * 8 - __builtin_clzl(n);
+
+    if (n > s->high_water)
+        s->high_water = n;
+    s->hist[b < MYFIFO_STATS_BUCKETS ? b : MYFIFO_STATS_BUCKETS - 1]++;
+}
+
+/* Adds the counters of src to dst, for FIFOs that keep one block per side */
+static inline void MyFIFOStatsAdd(MyFIFOStats_t *dst, const MyFIFOStats_t *src)
+{
+    int b;
+
+    if (src->high_water > dst->high_water)
+        dst->high_water = src->high_water;
+    dst->full += src->full;
+    dst->empty += src->empty;
+    for (b = 0; b < MYFIFO_STATS_BUCKETS; b++)
+        dst->hist[b] += src->hist[b];
+    dst->wait_ns += src->wait_ns;
+    dst->waits += src->waits;
+}
+
+#define MYFIFO_STATS_FIELD(f)       MyFIFOStats_t f;
+#define MYFIFO_STATS_RESET(s)       memset(&(s), 0, sizeof(s))
+#define MYFIFO_STAT_SIZE(s, n)      MyFIFOStatsSize(&(s), (n))
+#define MYFIFO_STAT_FULL(s)         ((s).full++)
+#define MYFIFO_STAT_EMPTY(s)        ((s).empty++)
+#define MYFIFO_STAT_CLOCK(t)        uint64_t t = MyFIFOStatsNow()
+#define MYFIFO_STAT_WAIT(s, t)      ((s).wait_ns += MyFIFOStatsNow() - (t), (s).waits++)
+#define MYFIFO_STATS_COPY(dst, s)   (*(dst) = (s), 0)
+
+#else
+
+/* Disabled: the fields do not exist and the updates expand to nothing */
+#define MYFIFO_STATS_FIELD(f)
+#define MYFIFO_STATS_RESET(s)       ((void)0)
+#define MYFIFO_STAT_SIZE(s, n)      ((void)0)
+#define MYFIFO_STAT_FULL(s)         ((void)0)
+#define MYFIFO_STAT_EMPTY(s)        ((void)0)
+#define MYFIFO_STAT_CLOCK(t)
+#define MYFIFO_STAT_WAIT(s, t)      ((void)0)
+#define MYFIFO_STATS_COPY(dst, s)   (memset((dst), 0, sizeof(*(dst))), -1)
+
+#endif
+
+#endif
@@ -1,19 +1,407 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/wait.h>
 #include "MyFIFO.h"
+#include "MyFIFOSpsc.h"
+#include "MyFIFOMpmc.h"
+#include "MyFIFOLossy.h"
+#include "MyFIFOMsg.h"
+#include "MyFIFOShm.h"
+#include "MyFIFOPrio.h"
+
+#define SPSC_SIZE  1024
+#define SPSC_ITEMS 1000000
+#define SPSC_BATCH 64
+
+static MyFIFOSpsc_t spsc;
+static int spsc_buf[SPSC_SIZE];
+
+static void *producer(void *arg)
+{
+    int i;
+
+    for (i = 1; i <= SPSC_ITEMS; i++)
+    {
+        while (MyFIFOSpscInsert(&spsc, i) != 0)
+            sched_yield();
+    }
+    return NULL;
+}
+
+static void spsc_demo()
+{
+    pthread_t tid;
+    long long sum = 0;
+    int batch[SPSC_BATCH];
+    size_t n, k;
+    int i;
+
+    MyFIFOSpscInit(&spsc, spsc_buf, SPSC_SIZE);
+    pthread_create(&tid, NULL, producer, NULL);
+
+    for (i = 0; i < SPSC_ITEMS; )
+    {
+        n = MyFIFOSpscPopBulk(&spsc, batch, SPSC_BATCH);
+        if (n == 0)
+            sched_yield();
+        for (k = 0; k < n; k++)
+            sum += batch[k];
+        i += n;
+    }
+    pthread_join(tid, NULL);
+
+    printf("SPSC: received %d elements, sum %lld\n", SPSC_ITEMS, sum);
+}
+
+#define WAIT_SIZE  16
+#define WAIT_ITEMS 100000
+
+static MyFIFOSpsc_t wfifo;
+static int wfifo_buf[WAIT_SIZE];
+
+static void *wait_producer(void *arg)
+{
+    int i;
+
+    for (i = 1; i <= WAIT_ITEMS; i++)
+    {
+        /* Pause now and then so the consumer has to park */
+        if (i % (WAIT_ITEMS / 4) == 0)
+            usleep(10000);
+        MyFIFOSpscInsertWait(&wfifo, i);
+    }
+    return NULL;
+}
+
+static void blocking_demo()
+{
+    MyFIFOStats_t st;
+    pthread_t tid;
+    long long sum = 0;
+    int i, value;
+
+    MyFIFOSpscInit(&wfifo, wfifo_buf, WAIT_SIZE);
+    pthread_create(&tid, NULL, wait_producer, NULL);
+
+    for (i = 0; i < WAIT_ITEMS; i++)
+    {
+        MyFIFOSpscRemoveWait(&wfifo, &value);
+        sum += value;
+    }
+    pthread_join(tid, NULL);
+
+    printf("Blocking SPSC: received %d elements, sum %lld\n", WAIT_ITEMS, sum);
+
+    /* Only filled in when built with -DMYFIFO_STATS */
+    if (MyFIFOSpscStats(&wfifo, &st) == 0)
+        printf("Blocking SPSC stats: high-water %zu, full %zu, empty %zu, %zu waits for %.3f ms\n",
+               st.high_water, st.full, st.empty, st.waits, st.wait_ns / 1e6);
+}
+
+#define LOSSY_SIZE  64
+#define LOSSY_ITEMS 1000000
+
+static MyFIFOLossy_t lossy;
+static MyFIFOLossySlot_t lossy_slots[LOSSY_SIZE];
+static atomic_int lossy_done;
+
+static void *lossy_writer(void *arg)
+{
+    int i;
+
+    for (i = 0; i < LOSSY_ITEMS; i++)
+        MyFIFOLossyInsert(&lossy, i);
+    atomic_store(&lossy_done, 1);
+    return NULL;
+}
+
+static void lossy_demo()
+{
+    pthread_t tid;
+    size_t received = 0;
+    int value, last = -1, ordered = 1, done;
+
+    MyFIFOLossyInit(&lossy, lossy_slots, LOSSY_SIZE);
+    pthread_create(&tid, NULL, lossy_writer, NULL);
+
+    /* Read until the writer is done and the queue is drained */
+    for (;;)
+    {
+        done = atomic_load(&lossy_done);
+        if (MyFIFOLossyRemove(&lossy, &value) == 0)
+        {
+            if (value <= last)
+                ordered = 0;
+            last = value;
+            received++;
+        }
+        else if (done)
+            break;
+        else
+            sched_yield();
+    }
+    pthread_join(tid, NULL);
+
+    printf("Lossy: received %zu, dropped %zu, in order: %s\n", received,
+           MyFIFOLossyDropped(&lossy), ordered ? "yes" : "no");
+}
+
+#define MSG_SIZE 256
+
+static void msg_demo()
+{
+    static _Alignas(MYFIFO_MSG_ALIGN) unsigned char storage[MSG_SIZE];
+    MyFIFOMsg_t mq;
+    int sample = 42;
+    int block[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    const char *line = "log: sensor ok";
+    const unsigned char *p;
+    size_t len;
+
+    MyFIFOMsgInit(&mq, storage, MSG_SIZE);
+    MyFIFOMsgWrite(&mq, &sample, sizeof(sample));
+    MyFIFOMsgWrite(&mq, block, sizeof(block));
+    MyFIFOMsgWrite(&mq, line, strlen(line) + 1);
+
+    while ((p = MyFIFOMsgPeek(&mq, &len)) != NULL)
+    {
+        printf("Message of %zu bytes", len);
+        if (len == strlen(line) + 1)
+            printf(": %s", (const char *)p);
+        printf("\n");
+        MyFIFOMsgRelease(&mq);
+    }
+}
+
+#define MPMC_SIZE    1024
+#define MPMC_THREADS 4
+
+static MyFIFOMpmc_t mpmc;
+static MyFIFOMpmcCell_t mpmc_cells[MPMC_SIZE];
+
+static void *mpmc_producer(void *arg)
+{
+    int i;
+
+    for (i = 1; i <= SPSC_ITEMS / MPMC_THREADS; i++)
+    {
+        while (MyFIFOMpmcInsert(&mpmc, i) != 0)
+            sched_yield();
+    }
+    return NULL;
+}
+
+static void *mpmc_consumer(void *arg)
+{
+    long long *sum = arg;
+    int i, value;
+
+    for (i = 0; i < SPSC_ITEMS / MPMC_THREADS; i++)
+    {
+        while (MyFIFOMpmcRemove(&mpmc, &value) != 0)
+            sched_yield();
+        *sum += value;
+    }
+    return NULL;
+}
+
+static void mpmc_demo()
+{
+    pthread_t prod[MPMC_THREADS], cons[MPMC_THREADS];
+    long long sums[MPMC_THREADS] = { 0 };
+    long long sum = 0;
+    int i;
+
+    MyFIFOMpmcInit(&mpmc, mpmc_cells, MPMC_SIZE);
+    for (i = 0; i < MPMC_THREADS; i++)
+    {
+        pthread_create(&prod[i], NULL, mpmc_producer, NULL);
+        pthread_create(&cons[i], NULL, mpmc_consumer, &sums[i]);
+    }
+    for (i = 0; i < MPMC_THREADS; i++)
+    {
+        pthread_join(prod[i], NULL);
+        pthread_join(cons[i], NULL);
+        sum += sums[i];
+    }
+
+    printf("MPMC: %d producers and %d consumers, sum %lld\n", MPMC_THREADS, MPMC_THREADS, sum);
+}
+
+/* A FIFO of doubles, generated from the same code as MyFIFO_t */
+MYFIFO_DECLARE(MyFIFODouble, double)
+MYFIFO_DEFINE(MyFIFODouble, double)
+
+#define FIFO_SIZE   64
+#define NQUEUES     32
+#define QUEUE_SIZE  16
+
+/* Storage for NQUEUES independent queues, no heap involved */
+static int pool[NQUEUES][QUEUE_SIZE];
+static MyFIFO_t queues[NQUEUES];
+
+#define BURST 40
+
+static void bulk_demo()
+{
+    MyFIFO_t fifo;
+    MyFIFOSpan_t span;
+    int buf[FIFO_SIZE];
+    int burst[BURST], out[BURST];
+    size_t i, n, k;
+    long long sum = 0;
+
+    MyFIFOInit(&fifo, buf, FIFO_SIZE);
+
+    /* Move the indices so the next burst wraps around the end of buf */
+    for (i = 0; i < BURST; i++)
+        burst[i] = i;
+    MyFIFOPushBulk(&fifo, burst, BURST);
+    MyFIFOPopBulk(&fifo, out, BURST);
+
+    /* Write a burst in place */
+    n = MyFIFOReserve(&fifo, BURST, &span);
+    for (k = 0; k < 2; k++)
+        for (i = 0; i < span.len[k]; i++)
+            span.ptr[k][i] = 100;
+    MyFIFOCommit(&fifo, n);
+
+    /* Read it in place */
+    n = MyFIFOPeekSpan(&fifo, &span);
+    for (k = 0; k < 2; k++)
+        for (i = 0; i < span.len[k]; i++)
+            sum += span.ptr[k][i];
+    MyFIFOConsume(&fifo, n);
+
+    printf("Bulk: %zu elements in two spans (%zu + %zu), sum %lld\n", n, span.len[0], span.len[1], sum);
+}
+
+#define PRIO_SIZE 8
+
+/* Urgent control events (level 0) overtake telemetry (level 3) */
+static void prio_demo()
+{
+    static int storage[4 * PRIO_SIZE];
+    MyFIFOPrio_t pq;
+    unsigned prio;
+    int i, value;
+
+    MyFIFOPrioInit(&pq, storage, PRIO_SIZE);
+    for (i = 0; i < 3; i++)
+        MyFIFOPrioInsert(&pq, 3, 100 + i);
+    MyFIFOPrioInsert(&pq, 0, 1);
+    MyFIFOPrioInsert(&pq, 1, 10);
+
+    printf("Priority FIFO:");
+    while (MyFIFOPrioRemove(&pq, &value, &prio) == 0)
+        printf(" %d(p%u)", value, prio);
+    printf("\n");
+}
+
+#define SHM_SIZE  256
+#define SHM_ITEMS 100000
+
+/* The child process opens the queue by name and produces, the parent consumes */
+static void shm_demo()
+{
+    MyFIFOShm_t q;
+    char name[64];
+    long long sum = 0;
+    pid_t pid;
+    int i, value;
+
+    snprintf(name, sizeof(name), "/myfifo-demo-%d", (int)getpid());
+    if (MyFIFOShmCreate(&q, name, SHM_SIZE) != 0)
+    {
+        perror("MyFIFOShmCreate");
+        return;
+    }
+
+    pid = fork();
+    if (pid == 0)
+    {
+        MyFIFOShm_t w;
+
+        if (MyFIFOShmOpen(&w, name) != 0)
+            _exit(1);
+        for (i = 1; i <= SHM_ITEMS; i++)
+            MyFIFOShmInsertWait(&w, i);
+        MyFIFOShmClose(&w);
+        _exit(0);
+    }
+
+    if (pid > 0)
+    {
+        for (i = 0; i < SHM_ITEMS; i++)
+        {
+            MyFIFOShmRemoveWait(&q, &value);
+            sum += value;
+        }
+        waitpid(pid, NULL, 0);
+        printf("Shared memory: received %d elements, sum %lld\n", SHM_ITEMS, sum);
+    }
+
+    MyFIFOShmClose(&q);
+    MyFIFOShmUnlink(name);
+}
 
 int main()
 {
-    MyFIFOInit();
-    MyFIFOInsert();
-    MyFIFOInsert();
-    MyFIFOInsert();
-    MyFIFOInsert();
-    MyFIFORemove();
-    MyFIFORemove();
-    MyFIFORemove();
-    MyFIFOPeep();
-    MyFIFOSize();
+    MyFIFO_t fifo;
+    int buf[FIFO_SIZE];
+    MyFIFODouble_t dfifo;
+    double dbuf[8];
+    double d;
+    int i, value;
+    size_t total = 0;
+
+    MyFIFOInit(&fifo, buf, FIFO_SIZE);
+    printf("Fifo just started.\n");
+
+    for (i = 1; i <= 4; i++)
+    {
+        if (MyFIFOInsert(&fifo, i) == 0)
+            printf("You just inserted a %d on the fifo\n", i);
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        if (MyFIFORemove(&fifo, &value) == 0)
+            printf("You just removed a %d from the fifo.\n", value);
+    }
+
+    if (MyFIFOPeep(&fifo, &value) == 0)
+        printf("oldest element: %d\n", value);
+
+    printf("The size of the FIFO is %zu\n", MyFIFOSize(&fifo));
+
+    MyFIFODoubleInit(&dfifo, dbuf, 8);
+    MyFIFODoubleInsert(&dfifo, 0.5);
+    MyFIFODoubleInsert(&dfifo, 1.5);
+    if (MyFIFODoubleRemove(&dfifo, &d) == 0)
+        printf("Double FIFO: removed %.1f, %zu left\n", d, MyFIFODoubleSize(&dfifo));
+
+    for (i = 0; i < NQUEUES; i++)
+    {
+        MyFIFOInit(&queues[i], pool[i], QUEUE_SIZE);
+        MyFIFOInsert(&queues[i], i);
+        total += MyFIFOSize(&queues[i]);
+    }
+    printf("%d independent queues hold %zu elements\n", NQUEUES, total);
+
+    bulk_demo();
+    msg_demo();
+    prio_demo();
+
+    spsc_demo();
+    mpmc_demo();
+    blocking_demo();
+    lossy_demo();
+    shm_demo();
 
     return 0;
 }
@@ -0,0 +1,523 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include "MyFIFO.h"
+#include "MyFIFOSpsc.h"
+#include "MyFIFOMpmc.h"
+#include "MyFIFOLossy.h"
+#include "MyFIFOMsg.h"
+#include "MyFIFOShm.h"
+#include "MyFIFOPrio.h"
+
+#define MAX_CAP     16384
+#define MAX_BATCH   256
+#define SAMPLE      64      /* one element in SAMPLE carries a timestamp */
+#define MAX_THREADS 64
+
+/*
+ * Every variant is driven through the same push/pop interface, so all of
+ * them run the same workload: producers send the sequence numbers of their
+ * share of the items in batches, consumers pop up to a batch at a time.
+ * push and pop move as many elements as they can and return the count.
+ */
+typedef struct {
+    const char *name;
+    int spsc;       /* one producer and one consumer thread are safe */
+    int mpmc;       /* several producers and consumers are safe */
+    int (*init)(size_t cap);
+    void (*fini)(void);
+    size_t (*push)(const int *src, size_t n);
+    size_t (*pop)(int *dst, size_t n);
+} bQueue_t;
+
+typedef struct {
+    const bQueue_t *q;
+    int first;          /* first sequence number of this producer */
+    int count;          /* items this producer sends, or 0 for a consumer */
+    int batch;
+    int cpu;
+    uint64_t *lat;      /* consumer: latency samples */
+    size_t nlat;
+} bThread_t;
+
+static int items = 1 << 20;
+static uint64_t *sent_ns;       /* send time of every SAMPLE-th item */
+static atomic_long received;
+static int ncpu;
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int cmpU64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/* Queue adapters */
+
+static MyFIFO_t plain;
+static MyFIFOSpsc_t spsc;
+static MyFIFOMpmc_t mpmc;
+static MyFIFOLossy_t lossy;
+static MyFIFOMsg_t msg;
+static MyFIFOShm_t shm;
+static MyFIFOPrio_t prio;
+#define PRIO_LEVELS (sizeof(prio.level) / sizeof(prio.level[0]))
+static char shm_name[64];
+static void *storage;
+
+static int plainInit(size_t cap)
+{
+    storage = malloc(cap * sizeof(int));
+    return storage == NULL ? -1 : MyFIFOInit(&plain, storage, cap);
+}
+
+static size_t plainPush(const int *src, size_t n)
+{
+    return MyFIFOPushBulk(&plain, src, n);
+}
+
+static size_t plainPop(int *dst, size_t n)
+{
+    return MyFIFOPopBulk(&plain, dst, n);
+}
+
+static int spscInit(size_t cap)
+{
+    storage = malloc(cap * sizeof(int));
+    return storage == NULL ? -1 : MyFIFOSpscInit(&spsc, storage, cap);
+}
+
+static size_t spscPush(const int *src, size_t n)
+{
+    return MyFIFOSpscPushBulk(&spsc, src, n);
+}
+
+static size_t spscPop(int *dst, size_t n)
+{
+    return MyFIFOSpscPopBulk(&spsc, dst, n);
+}
+
+/* Blocking mode: waits for room, and pop waits for the first element only */
+static size_t spscWaitPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        MyFIFOSpscInsertWait(&spsc, src[i]);
+    return n;
+}
+
+static size_t spscWaitPop(int *dst, size_t n)
+{
+    MyFIFOSpscRemoveWait(&spsc, &dst[0]);
+    return 1 + MyFIFOSpscPopBulk(&spsc, dst + 1, n - 1);
+}
+
+static int mpmcInit(size_t cap)
+{
+    storage = malloc(cap * sizeof(MyFIFOMpmcCell_t));
+    return storage == NULL ? -1 : MyFIFOMpmcInit(&mpmc, storage, cap);
+}
+
+static size_t mpmcPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOMpmcInsert(&mpmc, src[i]) == 0; i++)
+        ;
+    return i;
+}
+
+static size_t mpmcPop(int *dst, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOMpmcRemove(&mpmc, &dst[i]) == 0; i++)
+        ;
+    return i;
+}
+
+static int lossyInit(size_t cap)
+{
+    storage = malloc(cap * sizeof(MyFIFOLossySlot_t));
+    return storage == NULL ? -1 : MyFIFOLossyInit(&lossy, storage, cap);
+}
+
+static size_t lossyPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        MyFIFOLossyInsert(&lossy, src[i]);
+    return n;
+}
+
+static size_t lossyPop(int *dst, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOLossyRemove(&lossy, &dst[i]) == 0; i++)
+        ;
+    return i;
+}
+
+/* One record per int: 8-byte header plus the payload padded to 8 bytes */
+static int msgInit(size_t cap)
+{
+    storage = aligned_alloc(MYFIFO_MSG_ALIGN, cap * 16);
+    return storage == NULL ? -1 : MyFIFOMsgInit(&msg, storage, cap * 16);
+}
+
+static size_t msgPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOMsgWrite(&msg, &src[i], sizeof(int)) == 0; i++)
+        ;
+    return i;
+}
+
+static size_t msgPop(int *dst, size_t n)
+{
+    size_t i, len;
+
+    for (i = 0; i < n && MyFIFOMsgRead(&msg, &dst[i], sizeof(int), &len) == 0; i++)
+        ;
+    return i;
+}
+
+/* cap elements per level; the sequence number picks the level */
+static int prioInit(size_t cap)
+{
+    storage = malloc(PRIO_LEVELS * cap * sizeof(int));
+    return storage == NULL ? -1 : MyFIFOPrioInit(&prio, storage, cap);
+}
+
+static size_t prioPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOPrioInsert(&prio, src[i] % PRIO_LEVELS, src[i]) == 0; i++)
+        ;
+    return i;
+}
+
+static size_t prioPop(int *dst, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOPrioRemove(&prio, &dst[i], NULL) == 0; i++)
+        ;
+    return i;
+}
+
+static int shmInit(size_t cap)
+{
+    snprintf(shm_name, sizeof(shm_name), "/myfifo-bench-%d", (int)getpid());
+    return MyFIFOShmCreate(&shm, shm_name, cap);
+}
+
+static void shmFini(void)
+{
+    MyFIFOShmClose(&shm);
+    MyFIFOShmUnlink(shm_name);
+}
+
+static size_t shmPush(const int *src, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOShmInsert(&shm, src[i]) == 0; i++)
+        ;
+    return i;
+}
+
+static size_t shmPop(int *dst, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n && MyFIFOShmRemove(&shm, &dst[i]) == 0; i++)
+        ;
+    return i;
+}
+
+static void storageFini(void)
+{
+    free(storage);
+    storage = NULL;
+}
+
+/*
+ * The lossy FIFO never refuses an insert, so it only runs single-threaded.
+ * The priority FIFO is not thread-safe and pops by level, not in order.
+ */
+static const bQueue_t queues[] = {
+    { "MyFIFO",   0, 0, plainInit, storageFini, plainPush,    plainPop },
+    { "Spsc",     1, 0, spscInit,  storageFini, spscPush,     spscPop },
+    { "SpscWait", 1, 0, spscInit,  storageFini, spscWaitPush, spscWaitPop },
+    { "Mpmc",     1, 1, mpmcInit,  storageFini, mpmcPush,     mpmcPop },
+    { "Lossy",    0, 0, lossyInit, storageFini, lossyPush,    lossyPop },
+    { "Msg",      1, 0, msgInit,   storageFini, msgPush,      msgPop },
+    { "Shm",      1, 0, shmInit,   shmFini,     shmPush,      shmPop },
+    { "Prio",     0, 0, prioInit,  storageFini, prioPush,     prioPop },
+};
+
+/* Workload */
+
+static void pin(int cpu)
+{
+    cpu_set_t set;
+
+    CPU_ZERO(&set);
+    CPU_SET(cpu % ncpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/* Fills buf with the next n sequence numbers and stamps the sampled ones */
+static void produceBatch(int *buf, int seq, int n)
+{
+    uint64_t now = 0;
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        buf[i] = seq + i;
+        if ((seq + i) % SAMPLE == 0)
+        {
+            if (now == 0)
+                now = nowNs();
+            sent_ns[(seq + i) / SAMPLE] = now;
+        }
+    }
+}
+
+/* Records the latency of the sampled elements in buf */
+static void consumeBatch(bThread_t *t, const int *buf, size_t n)
+{
+    uint64_t now = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (buf[i] % SAMPLE == 0)
+        {
+            if (now == 0)
+                now = nowNs();
+            t->lat[t->nlat++] = now - sent_ns[buf[i] / SAMPLE];
+        }
+    }
+}
+
+static void *producer(void *arg)
+{
+    bThread_t *t = arg;
+    int buf[MAX_BATCH];
+    int sent, n;
+    size_t done;
+
+    pin(t->cpu);
+    for (sent = 0; sent < t->count; sent += n)
+    {
+        n = t->count - sent < t->batch ? t->count - sent : t->batch;
+        produceBatch(buf, t->first + sent, n);
+        for (done = 0; done < (size_t)n; )
+        {
+            size_t k = t->q->push(buf + done, n - done);
+
+            if (k == 0)
+                sched_yield();
+            done += k;
+        }
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg)
+{
+    bThread_t *t = arg;
+    int buf[MAX_BATCH];
+    size_t k;
+
+    pin(t->cpu);
+    while (atomic_load_explicit(&received, memory_order_relaxed) < items)
+    {
+        k = t->q->pop(buf, t->batch);
+        if (k == 0)
+        {
+            sched_yield();
+            continue;
+        }
+        consumeBatch(t, buf, k);
+        atomic_fetch_add_explicit(&received, k, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+/* Producer and consumer in the same thread: push a batch, pop it back */
+static void runSingle(bThread_t *t)
+{
+    int buf[MAX_BATCH];
+    int seq, n;
+    size_t k;
+
+    for (seq = 0; seq < items; seq += n)
+    {
+        n = items - seq < t->batch ? items - seq : t->batch;
+        produceBatch(buf, seq, n);
+        t->q->push(buf, n);
+        k = t->q->pop(buf, n);
+        consumeBatch(t, buf, k);
+    }
+}
+
+/* Runs one configuration and writes a CSV line */
+static void bench(const char *scenario, const bQueue_t *q, int threads, size_t cap, int batch)
+{
+    bThread_t t[MAX_THREADS];
+    pthread_t tid[MAX_THREADS];
+    uint64_t *lat, t0, elapsed;
+    size_t nlat = 0, per = items / SAMPLE + 1;
+    int i, np = threads / 2;
+
+    if (q->init(cap) != 0)
+    {
+        fprintf(stderr, "%s: cannot create a queue of %zu\n", q->name, cap);
+        return;
+    }
+
+    /* Room for every sample in each consumer, since one may get all of them */
+    lat = malloc(per * (threads - np) * sizeof(uint64_t));
+    if (lat == NULL)
+    {
+        fprintf(stderr, "%s: cannot allocate the latency samples\n", q->name);
+        q->fini();
+        return;
+    }
+    for (i = 0; i < threads; i++)
+    {
+        t[i].q = q;
+        t[i].batch = batch;
+        t[i].cpu = i;
+        t[i].lat = lat + per * (i < np ? 0 : i - np);
+        t[i].nlat = 0;
+        /* Producers split the items, each one with its own range of sequence numbers */
+        t[i].first = (int)((long long)items * i / (np ? np : 1));
+        t[i].count = i < np ? (int)((long long)items * (i + 1) / np) - t[i].first : 0;
+    }
+    atomic_store(&received, 0);
+
+    t0 = nowNs();
+    if (threads == 1)
+        runSingle(&t[0]);
+    else
+    {
+        for (i = 0; i < threads; i++)
+            pthread_create(&tid[i], NULL, i < np ? producer : consumer, &t[i]);
+        for (i = 0; i < threads; i++)
+            pthread_join(tid[i], NULL);
+    }
+    elapsed = nowNs() - t0;
+    q->fini();
+
+    /* Gather the samples of every consumer at the start of lat */
+    for (i = np; i < threads; i++)
+    {
+        memmove(lat + nlat, t[i].lat, t[i].nlat * sizeof(uint64_t));
+        nlat += t[i].nlat;
+    }
+
+    qsort(lat, nlat, sizeof(uint64_t), cmpU64);
+    printf("%s,%s,%d,%zu,%d,%d,%.0f,%llu,%llu,%llu\n", scenario, q->name, threads, cap, batch,
+           items, items * 1e9 / elapsed,
+           (unsigned long long)(nlat ? lat[nlat / 2] : 0),
+           (unsigned long long)(nlat ? lat[(nlat * 99 + 99) / 100 - 1] : 0),
+           (unsigned long long)(nlat ? lat[(nlat * 999 + 999) / 1000 - 1] : 0));
+    fflush(stdout);
+    free(lat);
+}
+
+int main(int argc, char *argv[])
+{
+    static const size_t caps[] = { 64, 1024, MAX_CAP };
+    static const int batches[] = { 1, 8, 64, MAX_BATCH };
+    size_t nq = sizeof(queues) / sizeof(queues[0]);
+    size_t q, c, b;
+    int maxThreads, threads, opt;
+
+    ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (ncpu < 1)
+        ncpu = 1;
+    maxThreads = ncpu < 2 ? 2 : ncpu;
+
+    /*
+     * -n N: items per run (default 1M)
+     * -t N: most threads in the MPMC runs (default one per CPU, at least 2)
+     */
+    while ((opt = getopt(argc, argv, "n:t:")) != -1)
+    {
+        if (opt == 'n')
+            items = atoi(optarg);
+        else if (opt == 't')
+            maxThreads = atoi(optarg);
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n items] [-t threads]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (items < 1 || maxThreads < 2 || maxThreads > MAX_THREADS)
+    {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    sent_ns = malloc((items / SAMPLE + 1) * sizeof(uint64_t));
+    if (sent_ns == NULL)
+        return 1;
+
+    printf("scenario,fifo,threads,capacity,batch,items,ops_per_s,p50_ns,p99_ns,p999_ns\n");
+
+    for (c = 0; c < sizeof(caps) / sizeof(caps[0]); c++)
+    {
+        for (b = 0; b < sizeof(batches) / sizeof(batches[0]); b++)
+        {
+            if ((size_t)batches[b] > caps[c])
+                continue;
+
+            for (q = 0; q < nq; q++)
+                bench("single", &queues[q], 1, caps[c], batches[b]);
+
+            for (q = 0; q < nq; q++)
+            {
+                if (queues[q].spsc)
+                    bench("spsc", &queues[q], 2, caps[c], batches[b]);
+            }
+
+            for (q = 0; q < nq; q++)
+            {
+                if (!queues[q].mpmc)
+                    continue;
+                for (threads = 2; threads <= maxThreads; threads += 2)
+                    bench("mpmc", &queues[q], threads, caps[c], batches[b]);
+            }
+        }
+    }
+
+    free(sent_ns);
+    return 0;
+}
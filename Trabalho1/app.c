@@ -1,22 +1,131 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
 #include "vinit.h"
-#include "vAvg.h"
-#include "vSum.h"
+#include "vStats.h"
+#include "vPool.h"
+#include "vMem.h"
+#include "vStream.h"
+#include "vGen.h"
 
-int main(){
+int main(int argc, char *argv[]){
 
-    int size;
-    printf("Escolha um tamanho de array:");
-    scanf("%d",&size);
+    size_t size;
+    char buf[32];
+    char *end;
+    int threads = 0;
+    int flags = 0;
+    int stream = -1;
+    int random = 0;
+    unsigned long long seed = 0;
+    int fd;
+    const char *path = NULL;
+    int opt;
+    vStats_t st;
+    vVec_t vect;
 
-    int vect[size];
+    /*
+     * -t N: numero de threads (por omissao, uma por CPU)
+     * -f ficheiro: le os valores de um ficheiro binario de ints
+     * -H: usa huge pages no array
+     * -s / -b: le inteiros em texto / binario do stdin (ou de -f) sem criar o array
+     * -r seed: preenche o array com valores pseudo-aleatorios em vez de 1, 2, 3, ...
+     */
+    while ((opt = getopt(argc, argv, "t:f:Hsbr:")) != -1)
+    {
+        if (opt == 't')
+            threads = atoi(optarg);
+        else if (opt == 'f')
+            path = optarg;
+        else if (opt == 'H')
+            flags |= V_MEM_HUGE;
+        else if (opt == 's')
+            stream = V_STREAM_TEXT;
+        else if (opt == 'b')
+            stream = V_STREAM_BINARY;
+        else if (opt == 'r')
+        {
+            random = 1;
+            seed = strtoull(optarg, NULL, 0);
+        }
+        else
+        {
+            printf("Uso: %s [-t threads] [-f ficheiro] [-H] [-s | -b] [-r seed]\n", argv[0]);
+            return 1;
+        }
+    }
 
-    vinit(vect,size);
+    if (vPoolInit(threads) != 0)
+        printf("Aviso: so foi possivel criar %d threads\n", vPoolThreads());
 
-    vSum(vect,size);
+    if (stream >= 0)
+    {
+        fd = (path != NULL) ? open(path, O_RDONLY) : STDIN_FILENO;
+        if (fd < 0 || vStreamFd(fd, stream, &st) != 0)
+        {
+            printf("Erro ao ler %s: %s\n", path ? path : "stdin", strerror(errno));
+            return 1;
+        }
+        if (fd != STDIN_FILENO)
+            close(fd);
+        /* Sem valores, min/max/media seriam so os valores iniciais de vStatsReset() */
+        if (st.n == 0)
+        {
+            printf("Erro ao ler %s: nenhum valor (no input)\n", path ? path : "stdin");
+            return 1;
+        }
+        vect.data = NULL;
+    }
+    else if (path != NULL)
+    {
+        if (vVecMap(&vect, path) != 0)
+        {
+            printf("Erro ao abrir %s: %s\n", path, strerror(errno));
+            return 1;
+        }
+    }
+    else
+    {
+        printf("Escolha um tamanho de array:");
+        /* strtoull aceita "-1" como ULLONG_MAX, por isso o sinal e rejeitado antes */
+        size = 0;
+        if (scanf("%31s",buf) == 1 && buf[0] != '-')
+        {
+            errno = 0;
+            size = strtoull(buf,&end,10);
+            if (errno != 0 || end == buf || *end != '\0')
+                size = 0;
+        }
+        if (size == 0)
+        {
+            printf("Tamanho invalido\n");
+            return 1;
+        }
 
-    vAvg(vect,size);
+        if (vVecAlloc(&vect, size, flags) != 0)
+        {
+            printf("Erro ao reservar memoria: %s\n", strerror(errno));
+            return 1;
+        }
+
+        if (random)
+            vGenRandom(vect.data,vect.size,seed);
+        else
+            vinit(vect.data,vect.size);
+    }
+
+    if (vect.data != NULL)
+        vStats(vect.data,vect.size,&st);
+
+    printf("Sum of all values is: %lld \n", st.sum);
+    printf("Avg of all values is: %.2f \n", st.mean);
+    printf("Min: %d Max: %d Variance: %.2f \n", st.min, st.max, st.variance);
+
+    vVecFree(&vect);
+    vPoolDestroy();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include "vinit.h"
+#include "vStats.h"
+#include "vSimd.h"
+#include "vPool.h"
+#include "vMem.h"
+#include "vGen.h"
+
+#define MIN_ELEMS   1024            /* 4 KiB, cabe na L1 */
+#define WARMUP      3
+#define MIN_REPS    11
+#define MAX_REPS    1001
+#define TARGET_NS   200000000.0     /* tempo aproximado por medicao */
+
+typedef void (*benchFn)(const void *ctx, int vect[], size_t size);
+
+static volatile long long sink;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int cmpDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void runVinit(const void *ctx, int vect[], size_t size)
+{
+    vinit(vect, size);
+    sink = vect[size - 1];
+}
+
+static void runRamp(const void *ctx, int vect[], size_t size)
+{
+    ((const vKernel_t *)ctx)->ramp(vect, size, 1);
+    sink = vect[size - 1];
+}
+
+static void runRandom(const void *ctx, int vect[], size_t size)
+{
+    vGenRandom(vect, size, 1);
+    sink = vect[size - 1];
+}
+
+static void runSum(const void *ctx, int vect[], size_t size)
+{
+    sink = ((const vKernel_t *)ctx)->sum(vect, size);
+}
+
+static void runKernelStats(const void *ctx, int vect[], size_t size)
+{
+    vStats_t st;
+
+    vStatsReset(&st);
+    st.shift = vect[0];
+    ((const vKernel_t *)ctx)->stats(vect, size, &st);
+    sink = st.sum;
+}
+
+static void runStats(const void *ctx, int vect[], size_t size)
+{
+    vStats_t st;
+
+    vStats(vect, size, &st);
+    sink = st.sum;
+}
+
+/* Corre fn com aquecimento e repeticoes e escreve uma linha CSV */
+static void bench(const char *name, benchFn fn, const void *ctx, int vect[], size_t size, double *t)
+{
+    double t0, est, median, p99;
+    int reps, i;
+
+    for (i = 0; i < WARMUP; i++)
+        fn(ctx, vect, size);
+
+    t0 = nowNs();
+    fn(ctx, vect, size);
+    est = nowNs() - t0;
+
+    reps = (int)(TARGET_NS / (est > 1.0 ? est : 1.0));
+    if (reps < MIN_REPS)
+        reps = MIN_REPS;
+    if (reps > MAX_REPS)
+        reps = MAX_REPS;
+
+    for (i = 0; i < reps; i++)
+    {
+        t0 = nowNs();
+        fn(ctx, vect, size);
+        t[i] = nowNs() - t0;
+    }
+
+    qsort(t, reps, sizeof(double), cmpDouble);
+    median = t[reps / 2];
+    p99 = t[(reps * 99 + 99) / 100 - 1];
+
+    printf("%s,%d,%zu,%zu,%d,%.0f,%.0f,%.4f,%.3f\n", name, vPoolThreads(), size,
+           size * sizeof(int), reps, median, p99, median / size, size * sizeof(int) / median);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t maxBytes = 256UL << 20;
+    size_t nk, size, k;
+    const vKernel_t *kernels;
+    char name[64];
+    int threads = 0;
+    double *t;
+    vVec_t vect;
+    int opt;
+
+    /*
+     * -t N: threads das variantes paralelas (por omissao, uma por CPU)
+     * -m MiB: maior array testado (por omissao 256 MiB, acima da LLC)
+     */
+    while ((opt = getopt(argc, argv, "t:m:")) != -1)
+    {
+        if (opt == 't')
+            threads = atoi(optarg);
+        else if (opt == 'm')
+            maxBytes = strtoul(optarg, NULL, 10) << 20;
+        else
+        {
+            fprintf(stderr, "Uso: %s [-t threads] [-m MiB]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (vVecAlloc(&vect, maxBytes / sizeof(int), 0) != 0)
+    {
+        fprintf(stderr, "Erro ao reservar memoria: %s\n", strerror(errno));
+        return 1;
+    }
+    t = malloc(MAX_REPS * sizeof(double));
+    if (t == NULL)
+        return 1;
+
+    vPoolInit(1);
+    kernels = vKernelList(&nk);
+
+    printf("kernel,threads,elements,bytes,reps,median_ns,p99_ns,ns_per_elem,gb_per_s\n");
+
+    for (size = MIN_ELEMS; size <= vect.size; size *= 4)
+    {
+        bench("vinit", runVinit, NULL, vect.data, size, t);
+        bench("vGenRandom", runRandom, NULL, vect.data, size, t);
+        for (k = 0; k < nk; k++)
+        {
+            if (!kernels[k].available)
+                continue;
+            snprintf(name, sizeof(name), "ramp-%s", kernels[k].name);
+            bench(name, runRamp, &kernels[k], vect.data, size, t);
+            snprintf(name, sizeof(name), "sum-%s", kernels[k].name);
+            bench(name, runSum, &kernels[k], vect.data, size, t);
+            snprintf(name, sizeof(name), "stats-%s", kernels[k].name);
+            bench(name, runKernelStats, &kernels[k], vect.data, size, t);
+        }
+    }
+
+    if (vPoolInit(threads) == 0 && vPoolThreads() > 1)
+    {
+        for (size = MIN_ELEMS; size <= vect.size; size *= 4)
+        {
+            bench("vinit-mt", runVinit, NULL, vect.data, size, t);
+            bench("vGenRandom-mt", runRandom, NULL, vect.data, size, t);
+            bench("vStats-mt", runStats, NULL, vect.data, size, t);
+        }
+    }
+
+    vPoolDestroy();
+    vVecFree(&vect);
+    free(t);
+
+    return 0;
+}
@@ -1,20 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "vAvg.h"
+#include "vStats.h"
 
-void vAvg(int vect[], int size)
+double vAvg(const int vect[], size_t size)
 {
+    vStats_t st;
 
-static double avg;
-static int i;
-static int sum=0;
+    vStats(vect, size, &st);
 
-for(i = 0; i < size; i++)
-{
-    sum = vect[i]+sum;
+    return st.mean;
 }
-
-avg = sum/size;
-
-printf("Avg of all values is: %.2f \n",avg);
-
-}
\ No newline at end of file
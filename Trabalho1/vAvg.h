@@ -1 +1,3 @@
-void vAvg(int vect[], int size);
+#include <stddef.h>
+
+double vAvg(const int vect[], size_t size);
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "vGen.h"
+#include "vSimd.h"
+#include "vPool.h"
+
+#define V_GOLDEN 0x9E3779B97F4A7C15ULL
+
+typedef struct {
+    int *vect;
+    size_t size;
+    int base;
+    unsigned long long seed;
+} vGenJob_t;
+
+/*
+ * Gerador baseado em contador (splitmix64): o valor i depende so de seed e i,
+ * por isso cada thread salta diretamente para o inicio da sua fatia.
+ */
+static int vGenAt(unsigned long long seed, size_t i)
+{
+    unsigned long long z = seed + (i + 1) * V_GOLDEN;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+
+    return (int)(unsigned)(z >> 32);
+}
+
+static void vGenRampTask(void *arg, int id, int nthreads)
+{
+    vGenJob_t *job = arg;
+    size_t begin, end;
+
+    vPoolSlice(job->size, id, nthreads, &begin, &end);
+    vKernelBest()->ramp(job->vect + begin, end - begin, (int)((unsigned)job->base + (unsigned)begin));
+}
+
+static void vGenRandomTask(void *arg, int id, int nthreads)
+{
+    vGenJob_t *job = arg;
+    size_t begin, end, i;
+
+    vPoolSlice(job->size, id, nthreads, &begin, &end);
+    for (i = begin; i < end; i++)
+        job->vect[i] = vGenAt(job->seed, i);
+}
+
+static void vGenRun(vTaskFn fn, vGenJob_t *job)
+{
+    /* Escolhe o kernel antes de lancar as threads */
+    vKernelBest();
+
+    if (vPoolThreads() > 1 && job->size >= V_PAR_MIN)
+        vPoolRun(fn, job);
+    else
+        fn(job, 0, 1);
+}
+
+void vGenRamp(int vect[], size_t size, int base)
+{
+    vGenJob_t job = { vect, size, base, 0 };
+
+    vGenRun(vGenRampTask, &job);
+}
+
+void vGenRandom(int vect[], size_t size, unsigned long long seed)
+{
+    vGenJob_t job = { vect, size, 0, seed };
+
+    vGenRun(vGenRandomTask, &job);
+}
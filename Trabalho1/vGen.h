@@ -0,0 +1,9 @@
+#ifndef VGEN_H
+#define VGEN_H
+
+#include <stddef.h>
+
+void vGenRamp(int vect[], size_t size, int base);
+void vGenRandom(int vect[], size_t size, unsigned long long seed);
+
+#endif
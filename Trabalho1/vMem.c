@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "vMem.h"
+
+#define V_HUGE_PAGE (2UL << 20)
+
+int vVecAlloc(vVec_t *v, size_t size, int flags)
+{
+    size_t bytes = size * sizeof(int);
+    void *p = MAP_FAILED;
+
+    if (size == 0 || size > SIZE_MAX / sizeof(int))
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+#ifdef MAP_HUGETLB
+    /* Sem MAP_NORESERVE: se nao houver huge pages o mmap falha em vez de dar SIGBUS */
+    if (flags & V_MEM_HUGE)
+    {
+        size_t huge = (bytes + V_HUGE_PAGE - 1) & ~(V_HUGE_PAGE - 1);
+
+        p = mmap(NULL, huge, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p != MAP_FAILED)
+            bytes = huge;
+        else
+            flags |= V_MEM_THP;
+    }
+#else
+    if (flags & V_MEM_HUGE)
+        flags |= V_MEM_THP;
+#endif
+
+    /* MAP_NORESERVE deixa reservar mais do que a RAM disponivel */
+    if (p == MAP_FAILED)
+    {
+        p = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (p == MAP_FAILED)
+            return -1;
+    }
+
+#ifdef MADV_HUGEPAGE
+    if (flags & V_MEM_THP)
+        madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    madvise(p, bytes, MADV_SEQUENTIAL);
+
+    v->data = p;
+    v->size = size;
+    v->bytes = bytes;
+    v->readonly = 0;
+
+    return 0;
+}
+
+/* Mapeia um ficheiro binario de ints (na ordem de bytes da maquina) so para leitura */
+int vVecMap(vVec_t *v, const char *path)
+{
+    struct stat sb;
+    void *p;
+    int fd;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -1;
+
+    if (fstat(fd, &sb) < 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    if ((size_t)sb.st_size < sizeof(int))
+    {
+        close(fd);
+        errno = EINVAL;
+        return -1;
+    }
+
+    p = mmap(NULL, sb.st_size, PROT_READ, MAP_PRIVATE | MAP_NORESERVE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return -1;
+
+    madvise(p, sb.st_size, MADV_SEQUENTIAL);
+
+    v->data = p;
+    v->size = sb.st_size / sizeof(int);
+    v->bytes = sb.st_size;
+    v->readonly = 1;
+
+    return 0;
+}
+
+void vVecFree(vVec_t *v)
+{
+    if (v->data != NULL)
+        munmap(v->data, v->bytes);
+
+    v->data = NULL;
+    v->size = 0;
+    v->bytes = 0;
+}
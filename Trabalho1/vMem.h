@@ -0,0 +1,20 @@
+#ifndef VMEM_H
+#define VMEM_H
+
+#include <stddef.h>
+
+#define V_MEM_THP   0x1   /* transparent huge pages (madvise) */
+#define V_MEM_HUGE  0x2   /* MAP_HUGETLB; se falhar usa V_MEM_THP */
+
+typedef struct {
+    int *data;
+    size_t size;    /* numero de elementos */
+    size_t bytes;   /* tamanho do mapeamento */
+    int readonly;
+} vVec_t;
+
+int vVecAlloc(vVec_t *v, size_t size, int flags);
+int vVecMap(vVec_t *v, const char *path);
+void vVecFree(vVec_t *v);
+
+#endif
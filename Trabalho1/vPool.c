@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "vPool.h"
+
+static pthread_t workers[V_MAX_THREADS];
+static int nworkers = 1;
+
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cv = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cv = PTHREAD_COND_INITIALIZER;
+static unsigned long generation;
+static int pending;
+static int stop;
+static vTaskFn task;
+static void *task_arg;
+
+static void *vPoolWorker(void *p)
+{
+    int id = (int)(intptr_t)p;
+    unsigned long seen = 0;
+    vTaskFn fn;
+    void *arg;
+
+    pthread_mutex_lock(&lock);
+    for (;;)
+    {
+        while (generation == seen && !stop)
+            pthread_cond_wait(&start_cv, &lock);
+        if (stop)
+            break;
+
+        seen = generation;
+        fn = task;
+        arg = task_arg;
+        pthread_mutex_unlock(&lock);
+
+        fn(arg, id, nworkers);
+
+        pthread_mutex_lock(&lock);
+        if (--pending == 0)
+            pthread_cond_signal(&done_cv);
+    }
+    pthread_mutex_unlock(&lock);
+
+    return NULL;
+}
+
+/* nthreads <= 0 usa o numero de CPUs online */
+int vPoolInit(int nthreads)
+{
+    int i;
+
+    if (nworkers > 1)
+        vPoolDestroy();
+
+    if (nthreads <= 0)
+        nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads < 1)
+        nthreads = 1;
+    if (nthreads > V_MAX_THREADS)
+        nthreads = V_MAX_THREADS;
+
+    stop = 0;
+    generation = 0;
+
+    /* A thread que chama vPoolRun() faz a parte 0 */
+    for (i = 1; i < nthreads; i++)
+    {
+        if (pthread_create(&workers[i], NULL, vPoolWorker, (void *)(intptr_t)i) != 0)
+            break;
+    }
+    nworkers = i;
+
+    return nworkers == nthreads ? 0 : -1;
+}
+
+int vPoolThreads(void)
+{
+    return nworkers;
+}
+
+void vPoolRun(vTaskFn fn, void *arg)
+{
+    if (nworkers == 1)
+    {
+        fn(arg, 0, 1);
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    task = fn;
+    task_arg = arg;
+    pending = nworkers - 1;
+    generation++;
+    pthread_cond_broadcast(&start_cv);
+    pthread_mutex_unlock(&lock);
+
+    fn(arg, 0, nworkers);
+
+    pthread_mutex_lock(&lock);
+    while (pending > 0)
+        pthread_cond_wait(&done_cv, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+void vPoolDestroy(void)
+{
+    int i;
+
+    pthread_mutex_lock(&lock);
+    stop = 1;
+    pthread_cond_broadcast(&start_cv);
+    pthread_mutex_unlock(&lock);
+
+    for (i = 1; i < nworkers; i++)
+        pthread_join(workers[i], NULL);
+
+    nworkers = 1;
+}
+
+/* Fronteiras alinhadas a linhas de cache para que duas threads nunca escrevam na mesma linha */
+void vPoolSlice(size_t size, int id, int nthreads, size_t *begin, size_t *end)
+{
+    const size_t line = V_CACHE_LINE / sizeof(int);
+
+    *begin = (size / nthreads * id) / line * line;
+    *end = (id == nthreads - 1) ? size : (size / nthreads * (id + 1)) / line * line;
+}
@@ -0,0 +1,18 @@
+#ifndef VPOOL_H
+#define VPOOL_H
+
+#include <stddef.h>
+
+#define V_CACHE_LINE  64
+#define V_MAX_THREADS 64
+#define V_PAR_MIN     (1 << 16)   /* abaixo disto nao compensa dividir */
+
+typedef void (*vTaskFn)(void *arg, int id, int nthreads);
+
+int vPoolInit(int nthreads);
+int vPoolThreads(void);
+void vPoolRun(vTaskFn fn, void *arg);
+void vPoolDestroy(void);
+void vPoolSlice(size_t size, int id, int nthreads, size_t *begin, size_t *end);
+
+#endif
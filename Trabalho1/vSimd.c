@@ -0,0 +1,363 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "vSimd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define V_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define V_NEON 1
+#endif
+
+static long long vSumScalar(const int vect[], size_t size)
+{
+    long long sum = 0;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        sum += vect[i];
+
+    return sum;
+}
+
+/*
+ * Os kernels de estatisticas acumulam sobre st: soma, minimo, maximo e
+ * m2 = soma de (x - st->shift)^2. O n e o shift sao geridos em vStats.c.
+ */
+static void vStatsScalar(const int vect[], size_t size, vStats_t *st)
+{
+    long long sum = 0;
+    int min = st->min, max = st->max;
+    double shift = st->shift, m2 = 0.0, d;
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        sum += vect[i];
+        if (vect[i] < min)
+            min = vect[i];
+        if (vect[i] > max)
+            max = vect[i];
+        d = vect[i] - shift;
+        m2 += d * d;
+    }
+
+    st->sum += sum;
+    st->min = min;
+    st->max = max;
+    st->m2 += m2;
+}
+
+/* vect[i] = base + i, com aritmetica sem sinal para o overflow dar a volta */
+static void vRampScalar(int vect[], size_t size, int base)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        vect[i] = (int)((unsigned)base + (unsigned)i);
+}
+
+#ifdef V_X86
+/* Cada int e estendido para 64 bits antes de somar, por isso nao ha overflow */
+__attribute__((target("sse4.1")))
+static long long vSumSse41(const int vect[], size_t size)
+{
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128();
+    __m128i acc3 = _mm_setzero_si128();
+    long long lanes[2];
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)(vect + i))));
+        acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)(vect + i + 2))));
+        acc2 = _mm_add_epi64(acc2, _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)(vect + i + 4))));
+        acc3 = _mm_add_epi64(acc3, _mm_cvtepi32_epi64(_mm_loadl_epi64((const __m128i *)(vect + i + 6))));
+    }
+
+    acc0 = _mm_add_epi64(_mm_add_epi64(acc0, acc1), _mm_add_epi64(acc2, acc3));
+    _mm_storeu_si128((__m128i *)lanes, acc0);
+
+    return lanes[0] + lanes[1] + vSumScalar(vect + i, size - i);
+}
+
+__attribute__((target("sse4.1")))
+static void vStatsSse41(const int vect[], size_t size, vStats_t *st)
+{
+    __m128i sum0 = _mm_setzero_si128();
+    __m128i sum1 = _mm_setzero_si128();
+    __m128i vmin = _mm_set1_epi32(st->min);
+    __m128i vmax = _mm_set1_epi32(st->max);
+    __m128d shift = _mm_set1_pd(st->shift);
+    __m128d m20 = _mm_setzero_pd();
+    __m128d m21 = _mm_setzero_pd();
+    __m128d d0, d1;
+    __m128i a, hi;
+    long long lsum[2];
+    int lmin[4], lmax[4];
+    double lm2[2];
+    size_t i = 0;
+    int k;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        a = _mm_loadu_si128((const __m128i *)(vect + i));
+        hi = _mm_srli_si128(a, 8);
+        sum0 = _mm_add_epi64(sum0, _mm_cvtepi32_epi64(a));
+        sum1 = _mm_add_epi64(sum1, _mm_cvtepi32_epi64(hi));
+        vmin = _mm_min_epi32(vmin, a);
+        vmax = _mm_max_epi32(vmax, a);
+        d0 = _mm_sub_pd(_mm_cvtepi32_pd(a), shift);
+        d1 = _mm_sub_pd(_mm_cvtepi32_pd(hi), shift);
+        m20 = _mm_add_pd(m20, _mm_mul_pd(d0, d0));
+        m21 = _mm_add_pd(m21, _mm_mul_pd(d1, d1));
+    }
+
+    _mm_storeu_si128((__m128i *)lsum, _mm_add_epi64(sum0, sum1));
+    _mm_storeu_si128((__m128i *)lmin, vmin);
+    _mm_storeu_si128((__m128i *)lmax, vmax);
+    _mm_storeu_pd(lm2, _mm_add_pd(m20, m21));
+
+    st->sum += lsum[0] + lsum[1];
+    st->m2 += lm2[0] + lm2[1];
+    for (k = 0; k < 4; k++)
+    {
+        if (lmin[k] < st->min)
+            st->min = lmin[k];
+        if (lmax[k] > st->max)
+            st->max = lmax[k];
+    }
+
+    vStatsScalar(vect + i, size - i, st);
+}
+
+__attribute__((target("sse4.1")))
+static void vRampSse41(int vect[], size_t size, int base)
+{
+    __m128i v = _mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3));
+    __m128i step = _mm_set1_epi32(4);
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        _mm_storeu_si128((__m128i *)(vect + i), v);
+        v = _mm_add_epi32(v, step);
+    }
+
+    vRampScalar(vect + i, size - i, (int)((unsigned)base + (unsigned)i));
+}
+
+__attribute__((target("avx2")))
+static long long vSumAvx2(const int vect[], size_t size)
+{
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+    long long lanes[4];
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        acc0 = _mm256_add_epi64(acc0, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(vect + i))));
+        acc1 = _mm256_add_epi64(acc1, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(vect + i + 4))));
+        acc2 = _mm256_add_epi64(acc2, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(vect + i + 8))));
+        acc3 = _mm256_add_epi64(acc3, _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i *)(vect + i + 12))));
+    }
+
+    acc0 = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+    _mm256_storeu_si256((__m256i *)lanes, acc0);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + vSumScalar(vect + i, size - i);
+}
+__attribute__((target("avx2")))
+static void vStatsAvx2(const int vect[], size_t size, vStats_t *st)
+{
+    __m256i sum0 = _mm256_setzero_si256();
+    __m256i sum1 = _mm256_setzero_si256();
+    __m256i vmin = _mm256_set1_epi32(st->min);
+    __m256i vmax = _mm256_set1_epi32(st->max);
+    __m256d shift = _mm256_set1_pd(st->shift);
+    __m256d m20 = _mm256_setzero_pd();
+    __m256d m21 = _mm256_setzero_pd();
+    __m256d d0, d1;
+    __m256i a;
+    __m128i lo, hi;
+    long long lsum[4];
+    int lmin[8], lmax[8];
+    double lm2[4];
+    size_t i = 0;
+    int k;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        a = _mm256_loadu_si256((const __m256i *)(vect + i));
+        lo = _mm256_castsi256_si128(a);
+        hi = _mm256_extracti128_si256(a, 1);
+        sum0 = _mm256_add_epi64(sum0, _mm256_cvtepi32_epi64(lo));
+        sum1 = _mm256_add_epi64(sum1, _mm256_cvtepi32_epi64(hi));
+        vmin = _mm256_min_epi32(vmin, a);
+        vmax = _mm256_max_epi32(vmax, a);
+        d0 = _mm256_sub_pd(_mm256_cvtepi32_pd(lo), shift);
+        d1 = _mm256_sub_pd(_mm256_cvtepi32_pd(hi), shift);
+        m20 = _mm256_add_pd(m20, _mm256_mul_pd(d0, d0));
+        m21 = _mm256_add_pd(m21, _mm256_mul_pd(d1, d1));
+    }
+
+    _mm256_storeu_si256((__m256i *)lsum, _mm256_add_epi64(sum0, sum1));
+    _mm256_storeu_si256((__m256i *)lmin, vmin);
+    _mm256_storeu_si256((__m256i *)lmax, vmax);
+    _mm256_storeu_pd(lm2, _mm256_add_pd(m20, m21));
+
+    st->sum += lsum[0] + lsum[1] + lsum[2] + lsum[3];
+    st->m2 += lm2[0] + lm2[1] + lm2[2] + lm2[3];
+    for (k = 0; k < 8; k++)
+    {
+        if (lmin[k] < st->min)
+            st->min = lmin[k];
+        if (lmax[k] > st->max)
+            st->max = lmax[k];
+    }
+
+    vStatsScalar(vect + i, size - i, st);
+}
+
+__attribute__((target("avx2")))
+static void vRampAvx2(int vect[], size_t size, int base)
+{
+    __m256i v = _mm256_add_epi32(_mm256_set1_epi32(base), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256i step = _mm256_set1_epi32(8);
+    size_t i = 0;
+
+    for (; i + 8 <= size; i += 8)
+    {
+        _mm256_storeu_si256((__m256i *)(vect + i), v);
+        v = _mm256_add_epi32(v, step);
+    }
+
+    vRampScalar(vect + i, size - i, (int)((unsigned)base + (unsigned)i));
+}
+#endif
+
+#ifdef V_NEON
+static long long vSumNeon(const int vect[], size_t size)
+{
+    int64x2_t acc0 = vdupq_n_s64(0);
+    int64x2_t acc1 = vdupq_n_s64(0);
+    size_t i = 0;
+
+    /* vpadal soma pares de int32 em int64 */
+    for (; i + 8 <= size; i += 8)
+    {
+        acc0 = vpadalq_s32(acc0, vld1q_s32(vect + i));
+        acc1 = vpadalq_s32(acc1, vld1q_s32(vect + i + 4));
+    }
+
+    acc0 = vaddq_s64(acc0, acc1);
+
+    return vgetq_lane_s64(acc0, 0) + vgetq_lane_s64(acc0, 1) + vSumScalar(vect + i, size - i);
+}
+
+static void vStatsNeon(const int vect[], size_t size, vStats_t *st)
+{
+    int64x2_t sum = vdupq_n_s64(0);
+    int32x4_t vmin = vdupq_n_s32(st->min);
+    int32x4_t vmax = vdupq_n_s32(st->max);
+    float64x2_t shift = vdupq_n_f64(st->shift);
+    float64x2_t m20 = vdupq_n_f64(0.0);
+    float64x2_t m21 = vdupq_n_f64(0.0);
+    float64x2_t d0, d1;
+    int32x4_t a;
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        a = vld1q_s32(vect + i);
+        sum = vpadalq_s32(sum, a);
+        vmin = vminq_s32(vmin, a);
+        vmax = vmaxq_s32(vmax, a);
+        d0 = vsubq_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(a))), shift);
+        d1 = vsubq_f64(vcvtq_f64_s64(vmovl_s32(vget_high_s32(a))), shift);
+        m20 = vfmaq_f64(m20, d0, d0);
+        m21 = vfmaq_f64(m21, d1, d1);
+    }
+
+    st->sum += vaddvq_s64(sum);
+    st->m2 += vaddvq_f64(vaddq_f64(m20, m21));
+    if (vminvq_s32(vmin) < st->min)
+        st->min = vminvq_s32(vmin);
+    if (vmaxvq_s32(vmax) > st->max)
+        st->max = vmaxvq_s32(vmax);
+
+    vStatsScalar(vect + i, size - i, st);
+}
+
+static void vRampNeon(int vect[], size_t size, int base)
+{
+    static const int lanes[4] = { 0, 1, 2, 3 };
+    int32x4_t v = vaddq_s32(vdupq_n_s32(base), vld1q_s32(lanes));
+    int32x4_t step = vdupq_n_s32(4);
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        vst1q_s32(vect + i, v);
+        v = vaddq_s32(v, step);
+    }
+
+    vRampScalar(vect + i, size - i, (int)((unsigned)base + (unsigned)i));
+}
+#endif
+
+/* Ordenada do mais lento para o mais rapido */
+static vKernel_t kernels[] = {
+    { "scalar", 1, vSumScalar, vStatsScalar, vRampScalar },
+#ifdef V_X86
+    { "sse4.1", 0, vSumSse41,  vStatsSse41,  vRampSse41 },
+    { "avx2",   0, vSumAvx2,   vStatsAvx2,   vRampAvx2 },
+#endif
+#ifdef V_NEON
+    { "neon",   1, vSumNeon,   vStatsNeon,   vRampNeon },
+#endif
+};
+
+#define NKERNELS (sizeof(kernels) / sizeof(kernels[0]))
+
+static const vKernel_t *best;
+
+static void vKernelProbe(void)
+{
+    size_t i;
+
+#ifdef V_X86
+    __builtin_cpu_init();
+    kernels[1].available = __builtin_cpu_supports("sse4.1");
+    kernels[2].available = __builtin_cpu_supports("avx2");
+#endif
+
+    for (i = 0; i < NKERNELS; i++)
+    {
+        if (kernels[i].available)
+            best = &kernels[i];
+    }
+}
+
+const vKernel_t *vKernelBest(void)
+{
+    if (best == NULL)
+        vKernelProbe();
+
+    return best;
+}
+
+const vKernel_t *vKernelList(size_t *count)
+{
+    if (best == NULL)
+        vKernelProbe();
+
+    *count = NKERNELS;
+    return kernels;
+}
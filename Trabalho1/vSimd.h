@@ -0,0 +1,22 @@
+#ifndef VSIMD_H
+#define VSIMD_H
+
+#include <stddef.h>
+#include "vStats.h"
+
+typedef long long (*vSumFn)(const int vect[], size_t size);
+typedef void (*vStatsFn)(const int vect[], size_t size, vStats_t *st);
+typedef void (*vRampFn)(int vect[], size_t size, int base);
+
+typedef struct {
+    const char *name;
+    int available;
+    vSumFn sum;
+    vStatsFn stats;
+    vRampFn ramp;
+} vKernel_t;
+
+const vKernel_t *vKernelBest(void);
+const vKernel_t *vKernelList(size_t *count);
+
+#endif
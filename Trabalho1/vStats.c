@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include "vStats.h"
+#include "vSimd.h"
+#include "vPool.h"
+
+/* Cada thread escreve o seu resultado parcial numa linha de cache propria */
+typedef struct {
+    vStats_t st;
+} __attribute__((aligned(V_CACHE_LINE))) vStatsSlot_t;
+
+typedef struct {
+    const int *vect;
+    size_t size;
+    vStatsSlot_t slot[V_MAX_THREADS];
+} vStatsJob_t;
+
+void vStatsReset(vStats_t *st)
+{
+    st->n = 0;
+    st->sum = 0;
+    st->min = INT_MAX;
+    st->max = INT_MIN;
+    st->shift = 0;
+    st->m2 = 0.0;
+    st->mean = 0.0;
+    st->variance = 0.0;
+}
+
+static void vStatsUpdateSerial(vStats_t *st, const int vect[], size_t size)
+{
+    if (size == 0)
+        return;
+
+    /* O primeiro valor serve de referencia para evitar cancelamento na variancia */
+    if (st->n == 0)
+        st->shift = vect[0];
+
+    vKernelBest()->stats(vect, size, st);
+    st->n += size;
+}
+
+static void vStatsTask(void *arg, int id, int nthreads)
+{
+    vStatsJob_t *job = arg;
+    size_t begin, end;
+
+    vPoolSlice(job->size, id, nthreads, &begin, &end);
+    vStatsReset(&job->slot[id].st);
+    vStatsUpdateSerial(&job->slot[id].st, job->vect + begin, end - begin);
+}
+
+void vStatsUpdate(vStats_t *st, const int vect[], size_t size)
+{
+    static vStatsJob_t job;
+    int i;
+
+    if (vPoolThreads() == 1 || size < V_PAR_MIN)
+    {
+        vStatsUpdateSerial(st, vect, size);
+        return;
+    }
+
+    /* Escolhe o kernel antes de lancar as threads */
+    vKernelBest();
+
+    job.vect = vect;
+    job.size = size;
+    vPoolRun(vStatsTask, &job);
+
+    for (i = 0; i < vPoolThreads(); i++)
+        vStatsMerge(st, &job.slot[i].st);
+}
+
+void vStatsMerge(vStats_t *dst, const vStats_t *src)
+{
+    double delta, dev;
+
+    if (src->n == 0)
+        return;
+
+    if (dst->n == 0)
+    {
+        *dst = *src;
+        return;
+    }
+
+    /* Passa o m2 de src para o shift de dst */
+    delta = (double)src->shift - dst->shift;
+    dev = (double)(src->sum - (long long)src->n * src->shift);
+
+    dst->m2 += src->m2 + 2.0 * delta * dev + src->n * delta * delta;
+    dst->sum += src->sum;
+    dst->n += src->n;
+    if (src->min < dst->min)
+        dst->min = src->min;
+    if (src->max > dst->max)
+        dst->max = src->max;
+}
+
+void vStatsFinish(vStats_t *st)
+{
+    double dev;
+
+    if (st->n == 0)
+    {
+        st->mean = 0.0;
+        st->variance = 0.0;
+        return;
+    }
+
+    dev = (double)(st->sum - (long long)st->n * st->shift);
+
+    st->mean = (double)st->sum / st->n;
+    st->variance = (st->m2 - dev * dev / st->n) / st->n;
+    if (st->variance < 0.0)
+        st->variance = 0.0;
+}
+
+void vStats(const int vect[], size_t size, vStats_t *st)
+{
+    vStatsReset(st);
+    vStatsUpdate(st, vect, size);
+    vStatsFinish(st);
+}
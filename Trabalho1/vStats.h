@@ -0,0 +1,23 @@
+#ifndef VSTATS_H
+#define VSTATS_H
+
+#include <stddef.h>
+
+typedef struct {
+    size_t n;
+    long long sum;
+    int min;
+    int max;
+    int shift;      /* valor de referencia usado no calculo da variancia */
+    double m2;      /* soma de (x - shift)^2 */
+    double mean;
+    double variance;
+} vStats_t;
+
+void vStatsReset(vStats_t *st);
+void vStatsUpdate(vStats_t *st, const int vect[], size_t size);
+void vStatsMerge(vStats_t *dst, const vStats_t *src);
+void vStatsFinish(vStats_t *st);
+void vStats(const int vect[], size_t size, vStats_t *st);
+
+#endif
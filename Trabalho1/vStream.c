@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "vStream.h"
+
+typedef struct {
+    char *data;
+    size_t len;     /* 0 marca o fim do ficheiro */
+    int full;
+} vBuf_t;
+
+typedef struct {
+    int fd;
+    int err;
+    vBuf_t buf[2];
+    pthread_mutex_t lock;
+    pthread_cond_t cv;
+} vStream_t;
+
+typedef struct {
+    int out[V_STREAM_BATCH];
+    size_t n;
+    long long val;
+    int neg;
+    int innum;
+    int range;      /* algum inteiro nao cabia num int */
+} vParser_t;
+
+/* Le ate encher o buffer, para que so o ultimo bloco possa ter um int incompleto */
+static ssize_t vReadFull(int fd, char *p, size_t len)
+{
+    size_t done = 0;
+    ssize_t r;
+
+    while (done < len)
+    {
+        r = read(fd, p + done, len - done);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0)
+            return -1;
+        if (r == 0)
+            break;
+        done += r;
+    }
+
+    return done;
+}
+
+/* Thread de leitura: enche um buffer enquanto o outro esta a ser processado */
+static void *vReader(void *arg)
+{
+    vStream_t *s = arg;
+    ssize_t r;
+    int k = 0;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&s->lock);
+        while (s->buf[k].full)
+            pthread_cond_wait(&s->cv, &s->lock);
+        pthread_mutex_unlock(&s->lock);
+
+        r = vReadFull(s->fd, s->buf[k].data, V_STREAM_CHUNK);
+
+        pthread_mutex_lock(&s->lock);
+        if (r < 0)
+        {
+            s->err = errno;
+            r = 0;
+        }
+        s->buf[k].len = r;
+        s->buf[k].full = 1;
+        pthread_cond_broadcast(&s->cv);
+        pthread_mutex_unlock(&s->lock);
+
+        if (r == 0)
+            break;
+        k ^= 1;
+    }
+
+    return NULL;
+}
+
+static void vParseText(vParser_t *p, const char *c, size_t len, vStats_t *st)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        if (c[i] >= '0' && c[i] <= '9')
+        {
+            /* Deixa de acumular logo que passa de INT_MAX (ou -INT_MIN), por isso nunca transborda */
+            if (p->val <= (long long)INT_MAX + p->neg)
+                p->val = p->val * 10 + (c[i] - '0');
+            p->innum = 1;
+            continue;
+        }
+
+        if (p->innum && p->val > (long long)INT_MAX + p->neg)
+            p->range = 1;
+        else if (p->innum)
+        {
+            p->out[p->n++] = (int)(p->neg ? -p->val : p->val);
+            if (p->n == V_STREAM_BATCH)
+            {
+                vStatsUpdate(st, p->out, p->n);
+                p->n = 0;
+            }
+        }
+        p->val = 0;
+        p->innum = 0;
+        p->neg = (c[i] == '-');
+    }
+}
+
+/*
+ * Le inteiros de fd em blocos de V_STREAM_CHUNK bytes e vai atualizando st.
+ * A leitura do bloco seguinte e feita noutra thread enquanto este e processado.
+ */
+int vStreamFd(int fd, int mode, vStats_t *st)
+{
+    vStream_t s = { .fd = fd, .lock = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER };
+    vParser_t *p = NULL;
+    pthread_t reader;
+    size_t len;
+    int k = 0;
+    int range = 0;
+
+    vStatsReset(st);
+
+    s.buf[0].data = malloc(V_STREAM_CHUNK);
+    s.buf[1].data = malloc(V_STREAM_CHUNK);
+    if (mode == V_STREAM_TEXT)
+        p = calloc(1, sizeof(*p));
+    if (s.buf[0].data == NULL || s.buf[1].data == NULL || (mode == V_STREAM_TEXT && p == NULL)
+        || pthread_create(&reader, NULL, vReader, &s) != 0)
+    {
+        free(s.buf[0].data);
+        free(s.buf[1].data);
+        free(p);
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (;;)
+    {
+        pthread_mutex_lock(&s.lock);
+        while (!s.buf[k].full)
+            pthread_cond_wait(&s.cv, &s.lock);
+        len = s.buf[k].len;
+        pthread_mutex_unlock(&s.lock);
+
+        if (len == 0)
+            break;
+
+        /* Num ficheiro binario um int incompleto no fim e ignorado */
+        if (mode == V_STREAM_BINARY)
+            vStatsUpdate(st, (const int *)s.buf[k].data, len / sizeof(int));
+        else
+            vParseText(p, s.buf[k].data, len, st);
+
+        pthread_mutex_lock(&s.lock);
+        s.buf[k].full = 0;
+        pthread_cond_broadcast(&s.cv);
+        pthread_mutex_unlock(&s.lock);
+        k ^= 1;
+    }
+
+    pthread_join(reader, NULL);
+
+    if (p != NULL)
+    {
+        vParseText(p, " ", 1, st);
+        vStatsUpdate(st, p->out, p->n);
+        range = p->range;
+    }
+    vStatsFinish(st);
+
+    free(s.buf[0].data);
+    free(s.buf[1].data);
+    free(p);
+
+    if (s.err)
+    {
+        errno = s.err;
+        return -1;
+    }
+
+    if (range)
+    {
+        errno = ERANGE;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef VSTREAM_H
+#define VSTREAM_H
+
+#include "vStats.h"
+
+#define V_STREAM_CHUNK  (1 << 20)   /* bytes por read(), multiplo de sizeof(int) */
+#define V_STREAM_BATCH  (1 << 16)   /* ints convertidos do texto antes de cada vStatsUpdate() */
+
+#define V_STREAM_TEXT   0
+#define V_STREAM_BINARY 1
+
+int vStreamFd(int fd, int mode, vStats_t *st);
+
+#endif
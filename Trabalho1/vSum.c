@@ -1,17 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "vSum.h"
+#include "vStats.h"
 
-void vSum(int vect[], int size)
+long long vSum(const int vect[], size_t size)
 {
-    static int sum = 0;
-    static int j, a;
+    vStats_t st;
 
-    for (j=0; j < size; j++)
-    {
-        a = vect[j];  
-        sum = sum + a;
-    }
+    vStats(vect, size, &st);
 
-    printf("Sum of all values is: %d \n", sum);
-
-}
\ No newline at end of file
+    return st.sum;
+}
@@ -1,2 +1,4 @@
-void vSum(int vect[], int size);
+#include <stddef.h>
+
+long long vSum(const int vect[], size_t size);
 
@@ -1,13 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include "vinit.h"
+#include "vGen.h"
 
-int vinit (int vect[],int size)
+void vinit (int vect[],size_t size)
 {
-    static int cnt = 1;
-    for(int i=0; i<size; i++)
-    {
-        vect[i]=cnt;
-        cnt++;
-    }
-return vect[size];
-}
\ No newline at end of file
+    vGenRamp(vect, size, 1);
+}
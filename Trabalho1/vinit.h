@@ -1 +1,3 @@
-int vinit (int vect[],int size);
+#include <stddef.h>
+
+void vinit (int vect[],size_t size);